@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include "attack_map.h"
+#include "bit_board.h"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Position = BitBoard::Position;
+
+struct MoveSequence
+{
+    AttackMap start;
+    std::vector<std::pair<Position, Position>> moves;
+};
+
+// Quiet moves and captures on a board with a chess-like mix of sliders and steppers.
+MoveSequence make_sequence()
+{
+    std::mt19937_64 rng{37};
+    constexpr std::array patterns{
+        AttackPattern::cardinal_slider,
+        AttackPattern::diagonal_slider,
+        AttackPattern::cardinal_and_diagonal_slider,
+        AttackPattern::step,
+    };
+    MoveSequence sequence;
+    for (int i = 0; i < 24; ++i) {
+        const Position position{static_cast<int>(rng() % 8), static_cast<int>(rng() % 8)};
+        if (sequence.start.pattern(position) == AttackPattern::none) {
+            sequence.start.place(position, patterns[rng() % patterns.size()]);
+        }
+    }
+    std::vector<Position> pieces;
+    sequence.start.occupancy().to_position_set(std::back_inserter(pieces));
+    for (int i = 0; i < 256; ++i) {
+        const auto from = pieces[rng() % pieces.size()];
+        auto to = from;
+        while (to == from) {
+            to = Position{static_cast<int>(rng() % 8), static_cast<int>(rng() % 8)};
+        }
+        sequence.moves.emplace_back(from, to);
+    }
+    return sequence;
+}
+
+void BM_AttackMapIncremental(benchmark::State& state)
+{
+    const auto sequence = make_sequence();
+    auto map = sequence.start;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& [from, to] = sequence.moves[i++ % sequence.moves.size()];
+        const auto undo = map.make_move(from, to);
+        benchmark::DoNotOptimize(map.attackers(to));
+        map.unmake_move(undo);
+    }
+}
+BENCHMARK(BM_AttackMapIncremental);
+
+void BM_AttackMapRebuild(benchmark::State& state)
+{
+    const auto sequence = make_sequence();
+    auto map = sequence.start;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& [from, to] = sequence.moves[i++ % sequence.moves.size()];
+        const auto undo = map.make_move(from, to);
+        map.rebuild();
+        benchmark::DoNotOptimize(map.attackers(to));
+        map.unmake_move(undo);
+        map.rebuild();
+    }
+}
+BENCHMARK(BM_AttackMapRebuild);
+
+} // namespace
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "bit_sliced_boards.h"
+#include "cpu_features.h"
+#include "kernels.h"
+
+#include <array>
+#include <random>
+#include <string>
+
+namespace {
+
+std::array<BitBoard, 64> make_block(const std::uint64_t seed)
+{
+    std::mt19937_64 rng{seed};
+    std::array<BitBoard, 64> boards;
+    for (auto& board : boards) {
+        board = BitBoard{rng()};
+    }
+    return boards;
+}
+
+void BM_TransposeNaive(benchmark::State& state)
+{
+    const auto boards = make_block(4);
+    for (auto _ : state) {
+        std::array<BitBoard::Bits, 64> planes{};
+        for (std::size_t board = 0; board < 64; ++board) {
+            const auto bits = boards[board].to_ullong();
+            for (std::size_t square = 0; square < 64; ++square) {
+                planes[square] |= ((bits >> (63 - square)) & 1) << (63 - board);
+            }
+        }
+        benchmark::DoNotOptimize(planes);
+    }
+}
+BENCHMARK(BM_TransposeNaive);
+
+void BM_Transpose(benchmark::State& state)
+{
+    const auto level = static_cast<CpuLevel>(state.range(0));
+    if (level > detected_cpu_level()) {
+        state.SkipWithError("cpu level not supported");
+        return;
+    }
+    const auto& selected = kernels_for(level);
+    std::array<BitBoard::Bits, 64> rows;
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        rows[i] = make_block(4)[i].to_ullong();
+    }
+    for (auto _ : state) {
+        selected.transpose_64x64(rows, rows);
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetLabel(std::string{to_string(level)});
+}
+BENCHMARK(BM_Transpose)->DenseRange(static_cast<int>(CpuLevel::generic), static_cast<int>(CpuLevel::avx512));
+
+void BM_CountGreaterScalar(benchmark::State& state)
+{
+    const auto lhs = make_block(5);
+    const auto rhs = make_block(6);
+    for (auto _ : state) {
+        BitBoard::Bits lanes = 0;
+        for (std::size_t board = 0; board < 64; ++board) {
+            if (lhs[board].count() > rhs[board].count()) {
+                lanes |= BitSlicedBoards::lane(board);
+            }
+        }
+        benchmark::DoNotOptimize(lanes);
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_CountGreaterScalar);
+
+void BM_CountGreaterSliced(benchmark::State& state)
+{
+    const BitSlicedBoards lhs{make_block(5)};
+    const BitSlicedBoards rhs{make_block(6)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs.count_greater(rhs));
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_CountGreaterSliced);
+
+} // namespace
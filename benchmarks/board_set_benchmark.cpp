@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "board_set.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <bit>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+enum class BoardKind
+{
+    random,  // every bit random: almost no two boards share a chunk
+    sparse,  // four to eight set squares, like piece placements in play
+    low_bits // random in the low 32 bits only: dense chunks
+};
+
+const char* kind_label(const BoardKind kind)
+{
+    switch (kind) {
+    case BoardKind::random:
+        return "random";
+    case BoardKind::sparse:
+        return "sparse";
+    case BoardKind::low_bits:
+        return "low_bits";
+    }
+    return "";
+}
+
+std::vector<BitBoard> make_boards(const benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto kind = static_cast<BoardKind>(state.range(1));
+    std::mt19937_64 rng{4};
+    std::vector<BitBoard> boards;
+    boards.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        switch (kind) {
+        case BoardKind::random:
+            boards.emplace_back(rng());
+            break;
+        case BoardKind::sparse: {
+            BitBoard::Bits bits = 0;
+            const auto squares = 4 + rng() % 5;
+            while (static_cast<std::size_t>(std::popcount(bits)) < squares) {
+                bits |= BitBoard::Bits{1} << (rng() % BitBoard::n_bits);
+            }
+            boards.emplace_back(bits);
+            break;
+        }
+        case BoardKind::low_bits:
+            boards.emplace_back(rng() & 0x0000'0000'ffff'ffff);
+            break;
+        }
+    }
+    return boards;
+}
+
+void add_size_counters(benchmark::State& state, const BoardSet& set)
+{
+    state.SetLabel(kind_label(static_cast<BoardKind>(state.range(1))));
+    state.counters["bytes_per_board"] = static_cast<double>(set.bytes().size()) / static_cast<double>(set.size());
+    state.counters["loose_fraction"] = static_cast<double>(set.view().loose_count()) / static_cast<double>(set.size());
+}
+
+void BM_StdSetBuild(benchmark::State& state)
+{
+    state.SetLabel(kind_label(static_cast<BoardKind>(state.range(1))));
+    const auto boards = make_boards(state);
+    for (auto _ : state) {
+        std::set<BitBoard> set{boards.begin(), boards.end()};
+        benchmark::DoNotOptimize(set.size());
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+void BM_BoardSetBuild(benchmark::State& state)
+{
+    const auto boards = make_boards(state);
+    for (auto _ : state) {
+        const auto set = BoardSet::from_unsorted(boards);
+        benchmark::DoNotOptimize(set.size());
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+    add_size_counters(state, BoardSet::from_unsorted(boards));
+}
+
+void BM_StdSetContains(benchmark::State& state)
+{
+    state.SetLabel(kind_label(static_cast<BoardKind>(state.range(1))));
+    const auto boards = make_boards(state);
+    const std::set<BitBoard> set{boards.begin(), boards.end()};
+    for (auto _ : state) {
+        for (const auto board : boards) {
+            benchmark::DoNotOptimize(set.contains(board));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+void BM_BoardSetContains(benchmark::State& state)
+{
+    const auto boards = make_boards(state);
+    const auto set = BoardSet::from_unsorted(boards);
+    for (auto _ : state) {
+        for (const auto board : boards) {
+            benchmark::DoNotOptimize(set.contains(board));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+    add_size_counters(state, set);
+}
+
+} // namespace
+
+// Arguments are the board count and the BoardKind.
+BENCHMARK(BM_StdSetBuild)->ArgsProduct({{1 << 20}, {0, 1, 2}});
+BENCHMARK(BM_BoardSetBuild)->ArgsProduct({{1 << 20}, {0, 1, 2}});
+BENCHMARK(BM_StdSetContains)->ArgsProduct({{1 << 20}, {0, 1, 2}});
+BENCHMARK(BM_BoardSetContains)->ArgsProduct({{1 << 20}, {0, 1, 2}});
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "board_sort.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+std::vector<BitBoard> make_boards(const std::size_t n)
+{
+    std::mt19937_64 rng{5};
+    std::vector<BitBoard> boards;
+    boards.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        boards.emplace_back(rng() & rng() & rng());
+    }
+    return boards;
+}
+
+constexpr std::size_t n_boards = 1 << 22;
+
+void BM_StdSetDedup(benchmark::State& state)
+{
+    const auto boards = make_boards(n_boards);
+    for (auto _ : state) {
+        std::set<BitBoard> unique;
+        for (const auto board : boards) {
+            unique.insert(board);
+        }
+        benchmark::DoNotOptimize(unique.size());
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+void BM_StdSortUnique(benchmark::State& state)
+{
+    const auto boards = make_boards(n_boards);
+    for (auto _ : state) {
+        auto sorted = boards;
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        benchmark::DoNotOptimize(sorted.size());
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+void BM_RadixSort(benchmark::State& state)
+{
+    const auto boards = make_boards(n_boards);
+    std::vector<BitBoard> scratch(boards.size());
+    for (auto _ : state) {
+        auto sorted = boards;
+        radix_sort(sorted, scratch);
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+void BM_ParallelSortUnique(benchmark::State& state)
+{
+    const auto boards = make_boards(n_boards);
+    const SortUniqueOptions options{static_cast<unsigned>(state.range(0)), false};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sort_unique(boards, options).size());
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_StdSetDedup)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdSortUnique)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RadixSort)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelSortUnique)->RangeMultiplier(2)->Range(1, 16)->Unit(benchmark::kMillisecond)->UseRealTime();
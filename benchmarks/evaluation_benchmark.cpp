@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "evaluation.h"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename Weight>
+SquareWeights<Weight> make_weights()
+{
+    std::mt19937_64 rng{1};
+    std::array<Weight, BitBoard::n_bits> weights{};
+    for (auto& weight : weights) {
+        weight = static_cast<Weight>(rng());
+    }
+    return SquareWeights<Weight>{weights};
+}
+
+std::vector<BitBoard> make_boards(const std::size_t n)
+{
+    std::mt19937_64 rng{2};
+    std::vector<BitBoard> boards;
+    boards.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        boards.emplace_back(rng());
+    }
+    return boards;
+}
+
+constexpr std::size_t n_boards = 4096;
+
+template <typename Weight>
+void BM_EvaluateNaive(benchmark::State& state)
+{
+    const auto weights = make_weights<Weight>();
+    const auto boards = make_boards(n_boards);
+    for (auto _ : state) {
+        for (const auto board : boards) {
+            Score score = 0;
+            for (const auto& position : board.to_position_vector()) {
+                score += weights[position];
+            }
+            benchmark::DoNotOptimize(score);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+template <typename Weight>
+void BM_EvaluateByteLanes(benchmark::State& state)
+{
+    const auto weights = make_weights<Weight>();
+    const auto boards = make_boards(n_boards);
+    for (auto _ : state) {
+        for (const auto board : boards) {
+            benchmark::DoNotOptimize(weights.evaluate(board));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+template <typename Weight>
+void BM_EvaluateBitSliced(benchmark::State& state)
+{
+    const auto weights = make_weights<Weight>();
+    const auto boards = make_boards(n_boards);
+    for (auto _ : state) {
+        for (const auto board : boards) {
+            benchmark::DoNotOptimize(weights.evaluate_bit_sliced(board));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+template <typename Weight>
+void BM_EvaluateBatch(benchmark::State& state)
+{
+    const auto weights = make_weights<Weight>();
+    const auto boards = make_boards(n_boards);
+    std::vector<Score> scores(boards.size());
+    for (auto _ : state) {
+        weights.evaluate(boards, scores);
+        benchmark::DoNotOptimize(scores.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_EvaluateNaive<std::int8_t>);
+BENCHMARK(BM_EvaluateByteLanes<std::int8_t>);
+BENCHMARK(BM_EvaluateByteLanes<std::int16_t>);
+BENCHMARK(BM_EvaluateBitSliced<std::int8_t>);
+BENCHMARK(BM_EvaluateBitSliced<std::int16_t>);
+BENCHMARK(BM_EvaluateBatch<std::int8_t>);
+BENCHMARK(BM_EvaluateBatch<std::int16_t>);
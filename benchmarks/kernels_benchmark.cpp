@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "kernels.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<BitBoard> make_boards(const std::size_t n)
+{
+    std::mt19937_64 rng{3};
+    std::vector<BitBoard> boards;
+    boards.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        boards.emplace_back(rng());
+    }
+    return boards;
+}
+
+void BM_CountTotal(benchmark::State& state)
+{
+    const auto level = static_cast<CpuLevel>(state.range(0));
+    if (level > detected_cpu_level()) {
+        state.SkipWithError("cpu level not supported");
+        return;
+    }
+    const auto& selected = kernels_for(level);
+    const auto boards = make_boards(4096);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(selected.count_total(boards));
+    }
+    state.SetLabel(std::string{to_string(level)});
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+void BM_ExtractBits(benchmark::State& state)
+{
+    const auto level = static_cast<CpuLevel>(state.range(0));
+    if (level > detected_cpu_level()) {
+        state.SkipWithError("cpu level not supported");
+        return;
+    }
+    const auto& selected = kernels_for(level);
+    const auto boards = make_boards(4096);
+    for (auto _ : state) {
+        for (std::size_t i = 1; i < boards.size(); ++i) {
+            benchmark::DoNotOptimize(selected.extract_bits(boards[i].to_ullong(), boards[i - 1].to_ullong()));
+        }
+    }
+    state.SetLabel(std::string{to_string(level)});
+    state.SetItemsProcessed(state.iterations() * (boards.size() - 1));
+}
+
+} // namespace
+
+BENCHMARK(BM_CountTotal)->DenseRange(static_cast<int>(CpuLevel::generic), static_cast<int>(CpuLevel::avx512));
+BENCHMARK(BM_ExtractBits)->DenseRange(static_cast<int>(CpuLevel::generic), static_cast<int>(CpuLevel::avx512));
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "leaper_attacks.h"
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<BitBoard> make_boards()
+{
+    std::mt19937_64 rng{41};
+    std::vector<BitBoard> boards(1024);
+    for (auto& board : boards) {
+        board = BitBoard{rng() & rng() & rng()};
+    }
+    return boards;
+}
+
+void BM_KnightAttacksPerSquare(benchmark::State& state)
+{
+    using Position = BitBoard::Position;
+    constexpr std::array<Position, 8> offsets{
+        Position{1, 2}, Position{1, -2}, Position{-1, 2}, Position{-1, -2},
+        Position{2, 1}, Position{2, -1}, Position{-2, 1}, Position{-2, -1},
+    };
+    const auto boards = make_boards();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        BitBoard attacks{};
+        for (const auto& knight : boards[i++ % boards.size()].to_bitboard_vector()) {
+            for (const auto& offset : offsets) {
+                attacks |= BitBoard::shift(knight, offset);
+            }
+        }
+        benchmark::DoNotOptimize(attacks);
+    }
+}
+BENCHMARK(BM_KnightAttacksPerSquare);
+
+void BM_KnightAttacks(benchmark::State& state)
+{
+    const auto boards = make_boards();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto attacks = knight_attacks(boards[i++ % boards.size()]);
+        benchmark::DoNotOptimize(attacks);
+    }
+}
+BENCHMARK(BM_KnightAttacks);
+
+void BM_LeaperAttacksRuntimeSteps(benchmark::State& state)
+{
+    const auto boards = make_boards();
+    const auto steps = leaper_steps(1, 2);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(steps);
+        auto attacks = leaper_attacks(boards[i++ % boards.size()], steps);
+        benchmark::DoNotOptimize(attacks);
+    }
+}
+BENCHMARK(BM_LeaperAttacksRuntimeSteps);
+
+} // namespace
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "leaper_attacks.h"
+#include "move_list.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Setup
+{
+    BitBoard pieces;
+    BitBoard blockers;
+};
+
+// Each piece moves like a knight and a king, so it has up to 16 targets.
+BitBoard targets_of(const BitBoard piece, const BitBoard blockers)
+{
+    return (knight_attacks(piece) | BitBoard::neighbors_cardinal_and_diagonal(piece)) & ~blockers;
+}
+
+std::vector<Setup> make_setups()
+{
+    std::mt19937_64 rng{42};
+    std::vector<Setup> setups(1024);
+    for (auto& setup : setups) {
+        setup.pieces = BitBoard{rng() & rng() & rng()};
+        setup.blockers = BitBoard{rng() & rng()} & ~setup.pieces;
+    }
+    return setups;
+}
+
+void BM_MovesToVector(benchmark::State& state)
+{
+    const auto setups = make_setups();
+    std::size_t i = 0;
+    std::size_t n_moves = 0;
+    for (auto _ : state) {
+        const auto& setup = setups[i++ % setups.size()];
+        std::vector<std::pair<BitBoard, BitBoard>> moves;
+        for (const auto& from : setup.pieces.to_bitboard_vector()) {
+            for (const auto& to : targets_of(from, setup.blockers).to_bitboard_vector()) {
+                moves.emplace_back(from, to);
+            }
+        }
+        n_moves += moves.size();
+        benchmark::DoNotOptimize(moves.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(n_moves));
+}
+BENCHMARK(BM_MovesToVector);
+
+void BM_MovesToMoveList(benchmark::State& state)
+{
+    const auto level = static_cast<CpuLevel>(state.range(0));
+    if (level > detected_cpu_level()) {
+        state.SkipWithError("cpu level not supported");
+        return;
+    }
+    force_cpu_level(level);
+    const auto setups = make_setups();
+    std::size_t i = 0;
+    std::size_t n_moves = 0;
+    for (auto _ : state) {
+        const auto& setup = setups[i++ % setups.size()];
+        MoveList<> moves;
+        for (auto pieces = setup.pieces.to_ullong(); pieces != 0; pieces &= pieces - 1) {
+            const auto from = BitBoard::n_bits - 1 - static_cast<std::size_t>(std::countr_zero(pieces));
+            const BitBoard piece{pieces & -pieces};
+            moves.add_moves(from, targets_of(piece, setup.blockers));
+        }
+        n_moves += moves.size();
+        benchmark::DoNotOptimize(moves.data());
+    }
+    reset_cpu_level();
+    state.SetLabel(std::string{to_string(level)});
+    state.SetItemsProcessed(static_cast<std::int64_t>(n_moves));
+}
+BENCHMARK(BM_MovesToMoveList)->DenseRange(static_cast<int>(CpuLevel::generic), static_cast<int>(CpuLevel::avx512));
+
+} // namespace
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "neighbor_counts.h"
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<BitBoard> make_boards()
+{
+    std::mt19937_64 rng{36};
+    std::vector<BitBoard> boards(1024);
+    for (auto& board : boards) {
+        board = BitBoard{rng()};
+    }
+    return boards;
+}
+
+void BM_NeighborCountsPerSquare(benchmark::State& state)
+{
+    const auto boards = make_boards();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto board = boards[i++ % boards.size()];
+        std::array<std::size_t, BitBoard::n_bits> counts;
+        for (int x = 0; x < 8; ++x) {
+            for (int y = 0; y < 8; ++y) {
+                counts[static_cast<std::size_t>(x * 8 + y)] =
+                    (BitBoard::neighbors_cardinal_and_diagonal(BitBoard::Position{x, y}) & board).count();
+            }
+        }
+        benchmark::DoNotOptimize(counts);
+    }
+}
+BENCHMARK(BM_NeighborCountsPerSquare);
+
+void BM_NeighborCounts(benchmark::State& state)
+{
+    const auto boards = make_boards();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto counts = neighbor_counts(boards[i++ % boards.size()]);
+        benchmark::DoNotOptimize(counts);
+    }
+}
+BENCHMARK(BM_NeighborCounts);
+
+void BM_NeighborCountsAtLeast(benchmark::State& state)
+{
+    const auto boards = make_boards();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto crowded = count_at_least(neighbor_counts(boards[i++ % boards.size()]), 5);
+        benchmark::DoNotOptimize(crowded);
+    }
+}
+BENCHMARK(BM_NeighborCountsAtLeast);
+
+void BM_NeighborCounts5x5(benchmark::State& state)
+{
+    const auto boards = make_boards();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto counts = neighbor_counts_5x5(boards[i++ % boards.size()]);
+        benchmark::DoNotOptimize(counts);
+    }
+}
+BENCHMARK(BM_NeighborCounts5x5);
+
+} // namespace
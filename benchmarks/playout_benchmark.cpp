@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "kernels.h"
+#include "playout.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<BitBoard> make_boards()
+{
+    std::mt19937_64 rng{38};
+    std::vector<BitBoard> boards(1024);
+    for (auto& board : boards) {
+        board = BitBoard{rng() | 1};
+    }
+    return boards;
+}
+
+void BM_SelectBit(benchmark::State& state)
+{
+    const auto level = static_cast<CpuLevel>(state.range(0));
+    if (level > detected_cpu_level()) {
+        state.SkipWithError("cpu level not supported");
+        return;
+    }
+    const auto& selected = kernels_for(level);
+    const auto boards = make_boards();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < boards.size(); ++i) {
+            benchmark::DoNotOptimize(selected.select_bit(boards[i].to_ullong(), i % 16));
+        }
+    }
+    state.SetLabel(std::string{to_string(level)});
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+BENCHMARK(BM_SelectBit)->DenseRange(static_cast<int>(CpuLevel::generic), static_cast<int>(CpuLevel::avx512));
+
+void BM_RandomSetBitVector(benchmark::State& state)
+{
+    const auto boards = make_boards();
+    Xoshiro256 rng{38};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto squares = boards[i++ % boards.size()].to_bitboard_vector();
+        benchmark::DoNotOptimize(squares[rng() % squares.size()]);
+    }
+}
+BENCHMARK(BM_RandomSetBitVector);
+
+void BM_RandomSetBit(benchmark::State& state)
+{
+    const auto boards = make_boards();
+    Xoshiro256 rng{38};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(random_set_bit(boards[i++ % boards.size()], rng));
+    }
+}
+BENCHMARK(BM_RandomSetBit);
+
+// Each benchmark thread owns a driver; items per second is playouts per second summed over threads.
+void BM_FourInARowPlayouts(benchmark::State& state)
+{
+    Xoshiro256 rng{38};
+    for (int thread = 0; thread < state.thread_index(); ++thread) {
+        rng.jump();
+    }
+    PlayoutDriver driver{FourInARow{}, rng};
+    const FourInARow::State start{BitBoard{}, BitBoard{}};
+    std::uint64_t plies = 0;
+    for (auto _ : state) {
+        const auto result = driver.run(start);
+        plies += result.plies;
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["plies"] = benchmark::Counter(static_cast<double>(plies), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_FourInARowPlayouts)
+    ->ThreadRange(1, static_cast<int>(std::max(1U, std::thread::hardware_concurrency())))
+    ->UseRealTime();
+
+} // namespace
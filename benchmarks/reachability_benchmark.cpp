@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "kernels.h"
+#include "reachability.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<ReachQuery> make_queries(const std::size_t n)
+{
+    std::mt19937_64 rng{43};
+    std::vector<ReachQuery> queries(n);
+    for (auto& query : queries) {
+        query.sources = BitBoard{BitBoard::Bits{1} << (rng() % BitBoard::n_bits)};
+        query.allowed = BitBoard{rng() | rng()};
+        query.targets = BitBoard{BitBoard::Bits{1} << (rng() % BitBoard::n_bits)};
+    }
+    return queries;
+}
+
+// The loop reachability replaces: dilate the whole reached set a fixed number of times.
+void BM_ReachFixedIterations(benchmark::State& state)
+{
+    const auto queries = make_queries(1024);
+    for (auto _ : state) {
+        for (const auto& query : queries) {
+            auto reached = query.sources;
+            for (std::size_t i = 0; i < BitBoard::n_bits; ++i) {
+                reached |= BitBoard::neighbors_cardinal(reached) & query.allowed;
+            }
+            benchmark::DoNotOptimize(reached.test_any(query.targets));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * queries.size()));
+}
+BENCHMARK(BM_ReachFixedIterations);
+
+void BM_Reach(benchmark::State& state)
+{
+    const auto queries = make_queries(1024);
+    for (auto _ : state) {
+        for (const auto& query : queries) {
+            benchmark::DoNotOptimize(reach(query, Neighborhood::cardinal));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * queries.size()));
+}
+BENCHMARK(BM_Reach);
+
+void BM_ReachBatch(benchmark::State& state)
+{
+    const auto level = static_cast<CpuLevel>(state.range(0));
+    if (level > detected_cpu_level()) {
+        state.SkipWithError("cpu level not supported");
+        return;
+    }
+    const auto& selected = kernels_for(level);
+    const auto queries = make_queries(1024);
+    std::vector<ReachResult> results(queries.size());
+    for (auto _ : state) {
+        selected.reach_batch(queries, results, Neighborhood::cardinal);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetLabel(std::string{to_string(level)});
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * queries.size()));
+}
+BENCHMARK(BM_ReachBatch)->DenseRange(static_cast<int>(CpuLevel::generic), static_cast<int>(CpuLevel::avx512));
+
+} // namespace
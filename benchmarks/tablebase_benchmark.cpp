@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include "bit_board.h"
+#include "tablebase.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <random>
+#include <vector>
+
+namespace {
+
+void BM_PlacementRoundTrip(benchmark::State& state)
+{
+    const PlacementIndexer indexer{{1, 3}};
+    std::mt19937_64 rng{39};
+    std::vector<std::uint64_t> indices(1024);
+    for (auto& index : indices) {
+        index = rng() % indexer.size();
+    }
+    std::array<BitBoard, 2> placement;
+    for (auto _ : state) {
+        for (const auto index : indices) {
+            indexer.placement(index, placement);
+            indexer.canonicalize(placement);
+            benchmark::DoNotOptimize(indexer.index(placement));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+BENCHMARK(BM_PlacementRoundTrip);
+
+// Items are positions per side; arguments are the number of cops and worker threads.
+void BM_BuildTablebase(benchmark::State& state)
+{
+    const CopsAndRobber game{static_cast<std::size_t>(state.range(0))};
+    const TablebaseOptions options{static_cast<unsigned>(state.range(1))};
+    std::uint64_t entries = 0;
+    for (auto _ : state) {
+        const auto tablebase = build_tablebase(game, options);
+        entries = tablebase.view().entries();
+        benchmark::DoNotOptimize(tablebase.view().bytes().data());
+    }
+    state.SetItemsProcessed(state.iterations() * entries);
+}
+BENCHMARK(BM_BuildTablebase)->ArgsProduct({{2}, {1, 2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
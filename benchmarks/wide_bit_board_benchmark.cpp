@@ -0,0 +1,158 @@
+#include <benchmark/benchmark.h>
+
+#include "wide_bit_board.h"
+
+#include <bitset>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t board_size = 19;
+using Bitset = std::bitset<board_size * board_size>;
+
+struct BitsetBoard
+{
+    static Bitset make_column(const std::size_t column)
+    {
+        Bitset board;
+        for (std::size_t row = 0; row < board_size; ++row) {
+            board.set(row * board_size + column);
+        }
+        return board;
+    }
+
+    inline static const Bitset not_left_column = ~make_column(0);
+    inline static const Bitset not_right_column = ~make_column(board_size - 1);
+
+    static Bitset neighbors_cardinal(const Bitset& board)
+    {
+        return ((board << 1) & not_left_column) | ((board >> 1) & not_right_column) | (board << board_size) |
+               (board >> board_size);
+    }
+
+    static Bitset flood_fill(Bitset seed, const Bitset& allowed)
+    {
+        seed &= allowed;
+        for (;;) {
+            const auto grown = (seed | neighbors_cardinal(seed)) & allowed;
+            if (grown == seed) {
+                return seed;
+            }
+            seed = grown;
+        }
+    }
+};
+
+struct Position
+{
+    GoBitBoard stones;
+    GoBitBoard empty;
+    std::vector<GoBitBoard::Position> seeds;
+};
+
+Position make_position()
+{
+    std::mt19937_64 rng{32};
+    Position position;
+    for (int x = 0; x < static_cast<int>(board_size); ++x) {
+        for (int y = 0; y < static_cast<int>(board_size); ++y) {
+            if (rng() % 2 == 0) {
+                position.stones.set(GoBitBoard::Position{x, y});
+                position.seeds.emplace_back(x, y);
+            }
+        }
+    }
+    position.empty = ~position.stones;
+    return position;
+}
+
+Bitset to_bitset(const GoBitBoard& board)
+{
+    Bitset bits;
+    board.for_each_position([&](const GoBitBoard::Position& position) {
+        bits.set(static_cast<std::size_t>(position.x()) * board_size + static_cast<std::size_t>(position.y()));
+    });
+    return bits;
+}
+
+void BM_WideNeighborsCardinal(benchmark::State& state)
+{
+    const auto position = make_position();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GoBitBoard::neighbors_cardinal(position.stones));
+    }
+}
+BENCHMARK(BM_WideNeighborsCardinal);
+
+void BM_BitsetNeighborsCardinal(benchmark::State& state)
+{
+    const auto stones = to_bitset(make_position().stones);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BitsetBoard::neighbors_cardinal(stones));
+    }
+}
+BENCHMARK(BM_BitsetNeighborsCardinal);
+
+void BM_WideFloodFill(benchmark::State& state)
+{
+    const auto position = make_position();
+    for (auto _ : state) {
+        for (const auto& seed : position.seeds) {
+            benchmark::DoNotOptimize(GoBitBoard::flood_fill(GoBitBoard{seed}, position.stones));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(position.seeds.size()));
+}
+BENCHMARK(BM_WideFloodFill);
+
+void BM_BitsetFloodFill(benchmark::State& state)
+{
+    const auto position = make_position();
+    const auto stones = to_bitset(position.stones);
+    for (auto _ : state) {
+        for (const auto& seed : position.seeds) {
+            Bitset seed_bits;
+            seed_bits.set(static_cast<std::size_t>(seed.x()) * board_size + static_cast<std::size_t>(seed.y()));
+            benchmark::DoNotOptimize(BitsetBoard::flood_fill(seed_bits, stones));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(position.seeds.size()));
+}
+BENCHMARK(BM_BitsetFloodFill);
+
+void BM_WideLiberties(benchmark::State& state)
+{
+    const auto position = make_position();
+    std::vector<GoBitBoard> groups;
+    for (const auto& seed : position.seeds) {
+        groups.push_back(GoBitBoard::flood_fill(GoBitBoard{seed}, position.stones));
+    }
+    for (auto _ : state) {
+        for (const auto& group : groups) {
+            benchmark::DoNotOptimize((GoBitBoard::neighbors_cardinal(group) & position.empty).count());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(groups.size()));
+}
+BENCHMARK(BM_WideLiberties);
+
+void BM_BitsetLiberties(benchmark::State& state)
+{
+    const auto position = make_position();
+    const auto empty = to_bitset(position.empty);
+    std::vector<Bitset> groups;
+    for (const auto& seed : position.seeds) {
+        groups.push_back(to_bitset(GoBitBoard::flood_fill(GoBitBoard{seed}, position.stones)));
+    }
+    for (auto _ : state) {
+        for (const auto& group : groups) {
+            benchmark::DoNotOptimize((BitsetBoard::neighbors_cardinal(group) & empty).count());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(groups.size()));
+}
+BENCHMARK(BM_BitsetLiberties);
+
+} // namespace
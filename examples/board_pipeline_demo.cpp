@@ -0,0 +1,163 @@
+// Streams every raw board file (native 64-bit words, as written by write_sort_unique) under the given paths
+// through read -> canonicalize -> features -> write, and prints per-stage statistics as CSV.
+//
+// usage: BoardPipelineDemo [--batch-size N] [--queue-capacity N] [--pooled THREADS] [--output FILE] PATH...
+
+#include "bit_board.h"
+#include "board_pipeline.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct DemoOptions
+{
+    PipelineOptions pipeline;
+    std::filesystem::path output;
+    std::vector<std::filesystem::path> files;
+};
+
+std::vector<std::filesystem::path> collect_files(const std::filesystem::path& path)
+{
+    std::vector<std::filesystem::path> files;
+    if (std::filesystem::is_directory(path)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{path}) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else {
+        files.push_back(path);
+    }
+    return files;
+}
+
+DemoOptions parse_options(const std::span<char*> args)
+{
+    DemoOptions options;
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string_view arg{args[i]};
+        const auto value = [&] {
+            if (++i == args.size()) {
+                throw std::invalid_argument(std::string{arg} + " needs a value");
+            }
+            return std::string{args[i]};
+        };
+        if (arg == "--batch-size") {
+            options.pipeline.batch_size = std::stoul(value());
+        } else if (arg == "--queue-capacity") {
+            options.pipeline.queue_capacity = std::stoul(value());
+        } else if (arg == "--pooled") {
+            options.pipeline.execution = PipelineExecution::pooled;
+            options.pipeline.pool_threads = static_cast<unsigned>(std::stoul(value()));
+        } else if (arg == "--output") {
+            options.output = value();
+        } else {
+            const auto files = collect_files(std::filesystem::path{arg});
+            options.files.insert(options.files.end(), files.begin(), files.end());
+        }
+    }
+    if (options.files.empty()) {
+        throw std::invalid_argument("no input files");
+    }
+    return options;
+}
+
+// Reads the files back to back, so batches span file boundaries and only the final batch is short.
+class CorpusReader
+{
+  public:
+    explicit CorpusReader(std::vector<std::filesystem::path> files) : files_(std::move(files)) {}
+
+    std::size_t operator()(std::span<BitBoard> boards)
+    {
+        static_assert(sizeof(BitBoard) == sizeof(BitBoard::Bits), "boards are read as raw words");
+        std::size_t n = 0;
+        while (n < boards.size()) {
+            if (!in_.is_open() || in_.eof()) {
+                if (next_file_ == files_.size()) {
+                    break;
+                }
+                in_ = std::ifstream{files_[next_file_++], std::ios::binary};
+                if (!in_) {
+                    throw std::runtime_error("cannot open " + files_[next_file_ - 1].string());
+                }
+            }
+            const auto rest = boards.subspan(n);
+            in_.read(reinterpret_cast<char*>(rest.data()), static_cast<std::streamsize>(rest.size_bytes()));
+            n += static_cast<std::size_t>(in_.gcount()) / sizeof(BitBoard);
+        }
+        return n;
+    }
+
+  private:
+    std::vector<std::filesystem::path> files_;
+    std::size_t next_file_{0};
+    std::ifstream in_;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        const auto options = parse_options(std::span{argv + 1, static_cast<std::size_t>(argc - 1)});
+
+        std::ofstream out;
+        if (!options.output.empty()) {
+            out.open(options.output, std::ios::binary);
+        }
+        std::array<std::uint64_t, BitBoard::n_bits + 1> count_histogram{};
+        std::uint64_t on_edge = 0;
+
+        const std::vector<PipelineStage> stages{
+            {"canonicalize", canonicalize_batch},
+            {"features", compute_features},
+        };
+        CorpusReader reader{options.files};
+        const auto stats = run_pipeline(
+            std::ref(reader),
+            stages,
+            [&](const BoardBatch& batch) {
+                const auto features = batch.active_features();
+                for (const auto& feature : features) {
+                    ++count_histogram[feature.count];
+                    on_edge += feature.on_any_edge;
+                }
+                if (out.is_open()) {
+                    const auto bytes = std::as_bytes(features);
+                    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+                }
+            },
+            options.pipeline
+        );
+
+        export_pipeline_stats(std::cout, stats);
+        std::cerr << stats.boards << " boards from " << options.files.size() << " files, " << on_edge
+                  << " touching an edge\n";
+        for (std::size_t count = 0; count < count_histogram.size(); ++count) {
+            if (count_histogram[count] != 0) {
+                std::cerr << "  " << count << " squares: " << count_histogram[count] << '\n';
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "BoardPipelineDemo: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+// Solves cops and robber with king moves by retrograde analysis, writes the tablebase, then maps the file back
+// and prints how each side fares.
+//
+// usage: TablebaseDemo [--cops N] [--threads N] OUTPUT
+
+#include "bit_board.h"
+#include "tablebase.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct DemoOptions
+{
+    std::size_t cops{2};
+    TablebaseOptions tablebase;
+    std::string output;
+};
+
+DemoOptions parse_options(const std::span<char*> args)
+{
+    DemoOptions options;
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string_view arg{args[i]};
+        const auto value = [&] {
+            if (++i == args.size()) {
+                throw std::invalid_argument(std::string{arg} + " needs a value");
+            }
+            return std::string{args[i]};
+        };
+        if (arg == "--cops") {
+            options.cops = std::stoul(value());
+        } else if (arg == "--threads") {
+            options.tablebase.threads = static_cast<unsigned>(std::stoul(value()));
+        } else {
+            options.output = arg;
+        }
+    }
+    if (options.output.empty()) {
+        throw std::invalid_argument("no output file");
+    }
+    return options;
+}
+
+// Read-only view of a whole file, memory-mapped where the platform allows it.
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::string& path)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        struct stat status{};
+        if (::fstat(fd, &status) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(status.st_size);
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            throw std::runtime_error("cannot map " + path);
+        }
+        data_ = static_cast<const std::byte*>(mapped);
+#else
+        std::ifstream in{path, std::ios::binary | std::ios::ate};
+        if (!in) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        copy_.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(copy_.data()), static_cast<std::streamsize>(copy_.size()));
+        data_ = copy_.data();
+        size_ = copy_.size();
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        ::munmap(const_cast<std::byte*>(data_), size_);
+#endif
+    }
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+    {
+        return {data_, size_};
+    }
+
+  private:
+    const std::byte* data_{nullptr};
+    std::size_t size_{0};
+    std::vector<std::byte> copy_;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        const auto options = parse_options(std::span{argv + 1, static_cast<std::size_t>(argc - 1)});
+        const CopsAndRobber game{options.cops};
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto built = build_tablebase(game, options.tablebase);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        {
+            std::ofstream out{options.output, std::ios::binary};
+            built.write(out);
+        }
+
+        const MappedFile file{options.output};
+        const auto view = TablebaseView::from_bytes(file.bytes());
+        std::cout << view.entries() << " positions per side, " << view.passes() << " passes, " << elapsed.count()
+                  << " s, " << file.bytes().size() << " bytes\n";
+        for (const auto side : {CopsAndRobber::cops_to_move, CopsAndRobber::robber_to_move}) {
+            std::cout << (side == CopsAndRobber::cops_to_move ? "cops" : "robber") << " to move: "
+                      << view.count(side, Outcome::win) << " won, " << view.count(side, Outcome::loss) << " lost, "
+                      << view.count(side, Outcome::draw) << " drawn\n";
+        }
+
+        // Robber in a corner, cops in the opposite corner.
+        const PlacementIndexer indexer{view.group_sizes()};
+        std::vector<BitBoard> placement{BitBoard::make_top_left(), BitBoard{}};
+        for (std::size_t cop = 0; cop < options.cops; ++cop) {
+            placement[1] |= BitBoard{BitBoard::Bits{1} << cop};
+        }
+        const auto outcome = view.probe(indexer, placement, CopsAndRobber::cops_to_move);
+        std::cout << "corner chase, cops to move: "
+                  << (outcome == Outcome::win ? "win" : outcome == Outcome::loss ? "loss" : "draw") << '\n';
+    } catch (const std::exception& e) {
+        std::cerr << "TablebaseDemo: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,448 @@
+#include "differential.h"
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "kernels.h"
+#include "move_list.h"
+#include "reference_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Bits = BitBoard::Bits;
+using Position = BitBoard::Position;
+using BoardFunction = BitBoard (*)(BitBoard);
+
+constexpr std::array<Direction, 8> directions{right, upright, up, upleft, left, downleft, down, downright};
+
+// Compile-time shifts and dilations are instantiated for 0 to board_size + 1 steps, so one table entry per
+// amount covers the case where everything leaves the board.
+constexpr std::size_t n_constant_amounts = BitBoard::board_size + 2;
+
+template <Direction D, std::size_t N>
+BitBoard constant_shift(const BitBoard board)
+{
+    return BitBoard::shift<D, N>(board);
+}
+
+template <Direction D, std::size_t N>
+BitBoard constant_dilate(BitBoard board)
+{
+    return board.dilate<D, N>();
+}
+
+template <std::size_t... N>
+constexpr auto constant_shift_table(std::index_sequence<N...>)
+{
+    return std::array{
+        std::array<BoardFunction, sizeof...(N)>{&constant_shift<right, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_shift<upright, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_shift<up, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_shift<upleft, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_shift<left, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_shift<downleft, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_shift<down, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_shift<downright, N>...},
+    };
+}
+
+template <std::size_t... N>
+constexpr auto constant_dilate_table(std::index_sequence<N...>)
+{
+    return std::array{
+        std::array<BoardFunction, sizeof...(N)>{&constant_dilate<right, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_dilate<upright, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_dilate<up, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_dilate<upleft, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_dilate<left, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_dilate<downleft, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_dilate<down, N>...},
+        std::array<BoardFunction, sizeof...(N)>{&constant_dilate<downright, N>...},
+    };
+}
+
+// Indexed by Direction, then by the number of steps.
+constexpr auto constant_shifts = constant_shift_table(std::make_index_sequence<n_constant_amounts>{});
+constexpr auto constant_dilations = constant_dilate_table(std::make_index_sequence<n_constant_amounts>{});
+
+enum class Operation
+{
+    shift,
+    shift_offset,
+    constant_shift,
+    dilate,
+    constant_dilate,
+    neighbors,
+    symmetry,
+    combine,
+    set_square,
+    clear_square,
+    parse,
+    complement,
+};
+
+static_assert(static_cast<std::size_t>(Operation::complement) + 1 == differential_operations);
+
+class InputReader
+{
+  public:
+    explicit InputReader(const std::span<const std::uint8_t> data) noexcept : data_(data) {}
+
+    [[nodiscard]] bool done() const noexcept
+    {
+        return next_ >= data_.size();
+    }
+    std::uint8_t byte() noexcept
+    {
+        return next_ < data_.size() ? data_[next_++] : 0;
+    }
+    Bits word() noexcept
+    {
+        Bits bits = 0;
+        for (std::size_t i = 0; i < sizeof(Bits); ++i) {
+            bits = (bits << 8) | byte();
+        }
+        return bits;
+    }
+    Direction direction() noexcept
+    {
+        return directions[byte() % directions.size()];
+    }
+
+  private:
+    std::span<const std::uint8_t> data_;
+    std::size_t next_{0};
+};
+
+[[noreturn]] void fail(const std::string_view what, const BitBoard actual, const ReferenceBoard& expected)
+{
+    std::cerr << "differential mismatch: " << what << std::hex << std::setfill('0') << "\n  bitboard  0x"
+              << std::setw(16) << actual.to_ullong() << "\n  reference 0x" << std::setw(16)
+              << expected.to_bitboard().to_ullong() << std::endl;
+    std::abort();
+}
+
+void check(const bool agrees, const std::string_view what, const BitBoard actual, const ReferenceBoard& expected)
+{
+    if (!agrees) {
+        fail(what, actual, expected);
+    }
+}
+
+const std::vector<CpuLevel>& supported_levels()
+{
+    static const auto levels = [] {
+        std::vector<CpuLevel> result;
+        for (auto level = CpuLevel::generic; level <= detected_cpu_level();
+             level = static_cast<CpuLevel>(static_cast<int>(level) + 1)) {
+            result.push_back(level);
+        }
+        return result;
+    }();
+    return levels;
+}
+
+void check_queries(const BitBoard board, const ReferenceBoard& reference)
+{
+    check(board.count() == reference.count(), "count", board, reference);
+    check(board.empty() == (reference.count() == 0), "empty", board, reference);
+    check(board.has_single_position() == (reference.count() == 1), "has_single_position", board, reference);
+    bool on_any_edge = false;
+    for (const auto direction : directions) {
+        check(board.on_edge(direction) == reference.on_edge(direction), "on_edge", board, reference);
+        on_any_edge = on_any_edge || reference.on_edge(direction);
+    }
+    check(board.on_any_edge() == on_any_edge, "on_any_edge", board, reference);
+    for (int x = 0; x < ReferenceBoard::size; ++x) {
+        for (int y = 0; y < ReferenceBoard::size; ++y) {
+            check(board.test(Position{x, y}) == reference.get(x, y), "test", board, reference);
+        }
+    }
+}
+
+void check_iteration(const BitBoard board, const ReferenceBoard& reference)
+{
+    const auto text = board.to_string();
+    check(text == reference.to_string(), "to_string", board, reference);
+    check(BitBoard{text} == board, "string round trip", board, reference);
+
+    const auto by_row = reference.positions_by_row();
+    check(board.to_position_vector() == reference.positions_by_column(), "to_position_vector", board, reference);
+    check(
+        board.to_position_set() == std::set<Position>(by_row.begin(), by_row.end()), "to_position_set", board, reference
+    );
+    const auto boards = board.to_bitboard_vector();
+    bool same_boards = boards.size() == by_row.size();
+    for (std::size_t i = 0; same_boards && i < boards.size(); ++i) {
+        same_boards = boards[i] == BitBoard{by_row[i]};
+    }
+    check(same_boards, "to_bitboard_vector", board, reference);
+    if (by_row.size() == 1) {
+        check(board.to_position() == by_row.front(), "to_position", board, reference);
+    }
+}
+
+// The batch kernels of each level on board, with other as a second operand.
+void check_kernels(const BitBoard board, const ReferenceBoard& reference, const BitBoard other, const Move base)
+{
+    const auto bits = static_cast<Bits>(board.to_ullong());
+    const auto other_bits = static_cast<Bits>(other.to_ullong());
+    const auto count = reference.count();
+    const auto indices = reference.square_indices();
+    const std::array boards{board, other};
+    const std::array words{bits, other_bits};
+
+    for (const auto level : supported_levels()) {
+        const auto& k = kernels_for(level);
+        check(k.count_total(boards) == count + other.count(), "count_total", board, reference);
+        check(k.count_words(words) == count + other.count(), "count_words", board, reference);
+        std::array<std::uint8_t, 2> counts{};
+        k.count_each(boards, counts);
+        check(counts[0] == count && counts[1] == other.count(), "count_each", board, reference);
+
+        std::array<std::uint8_t, BitBoard::n_bits> found{};
+        const auto n_found = k.square_indices(board, found);
+        check(
+            n_found == indices.size() && std::equal(indices.begin(), indices.end(), found.begin()),
+            "square_indices",
+            board,
+            reference
+        );
+
+        check(
+            k.extract_bits(bits, other_bits) == reference_extract_bits(bits, other_bits), "extract_bits", board, reference
+        );
+        check(
+            k.deposit_bits(bits, other_bits) == reference_deposit_bits(bits, other_bits), "deposit_bits", board, reference
+        );
+        for (const auto n : {std::size_t{0}, count / 2, count == 0 ? 0 : count - 1, count, count + 1}) {
+            check(k.select_bit(bits, n) == reference_select_bit(bits, n), "select_bit", board, reference);
+        }
+
+        std::array<Move, BitBoard::n_bits> moves;
+        const auto n_moves = k.serialize_moves(base, bits, moves);
+        bool same_moves = n_moves == indices.size();
+        // Least significant bit first, i.e. in descending square order.
+        for (std::size_t i = 0; same_moves && i < n_moves; ++i) {
+            same_moves = moves[i] == Move{base.from(), indices[indices.size() - 1 - i], base.flags()};
+        }
+        check(same_moves, "serialize_moves", board, reference);
+    }
+}
+
+// Characters mostly '0' and '1' so that parses succeed often, with the occasional stray byte.
+std::string read_board_text(InputReader& input)
+{
+    const auto length_byte = input.byte();
+    const std::size_t length = length_byte < 192 ? BitBoard::n_bits : length_byte % (BitBoard::n_bits + 8);
+    std::string text;
+    for (std::size_t i = 0; i < length; ++i) {
+        const auto c = input.byte();
+        text += c < 248 ? static_cast<char>('0' + (c & 1)) : static_cast<char>(c);
+    }
+    return text;
+}
+
+// A square byte names columns and rows from -1 to 8, so some squares lie just off the board.
+Position read_square(InputReader& input)
+{
+    const int x = input.byte() % (ReferenceBoard::size + 2) - 1;
+    const int y = input.byte() % (ReferenceBoard::size + 2) - 1;
+    return Position{x, y};
+}
+
+template <typename Apply>
+void check_throws_off_board(const Position square, BitBoard& board, ReferenceBoard& reference, Apply apply)
+{
+    const bool on_board = ReferenceBoard::on_board(square.x(), square.y());
+    try {
+        apply(board, reference);
+        check(on_board, "square outside of board accepted", board, reference);
+    } catch (const std::invalid_argument&) {
+        check(!on_board, "square on board rejected", board, reference);
+    }
+}
+
+void apply(const Operation operation, InputReader& input, BitBoard& board, ReferenceBoard& reference)
+{
+    switch (operation) {
+    case Operation::shift: {
+        const auto direction = input.direction();
+        const std::size_t n = input.byte();
+        board.shift_assign(direction, n);
+        reference = reference.shifted(direction, n);
+        return;
+    }
+    case Operation::shift_offset: {
+        const int dx = static_cast<std::int8_t>(input.byte());
+        const int dy = static_cast<std::int8_t>(input.byte());
+        board = BitBoard::shift(board, Position{dx, dy});
+        reference = reference.shifted(dx, dy);
+        return;
+    }
+    case Operation::constant_shift: {
+        const auto direction = input.direction();
+        const std::size_t n = input.byte() % n_constant_amounts;
+        board = constant_shifts[static_cast<std::size_t>(direction)][n](board);
+        reference = reference.shifted(direction, n);
+        return;
+    }
+    case Operation::dilate: {
+        const auto direction = input.direction();
+        const std::size_t n = input.byte() % (2 * BitBoard::board_size);
+        board.dilate(direction, n);
+        reference = reference.dilated(direction, n);
+        return;
+    }
+    case Operation::constant_dilate: {
+        const auto direction = input.direction();
+        const std::size_t n = input.byte() % n_constant_amounts;
+        board = constant_dilations[static_cast<std::size_t>(direction)][n](board);
+        reference = reference.dilated(direction, n);
+        return;
+    }
+    case Operation::neighbors:
+        switch (input.byte() % 3) {
+        case 0:
+            board = BitBoard::neighbors_cardinal(board);
+            reference = reference.neighbors(true, false);
+            return;
+        case 1:
+            board = BitBoard::neighbors_diagonal(board);
+            reference = reference.neighbors(false, true);
+            return;
+        default:
+            board = BitBoard::neighbors_cardinal_and_diagonal(board);
+            reference = reference.neighbors(true, true);
+            return;
+        }
+    case Operation::symmetry:
+        switch (input.byte() % 8) {
+        case 0:
+            board = BitBoard::flip_vertical(board);
+            reference = reference.flip_vertical();
+            return;
+        case 1:
+            board = BitBoard::flip_horizontal(board);
+            reference = reference.flip_horizontal();
+            return;
+        case 2:
+            board = BitBoard::flip_diagonal(board);
+            reference = reference.flip_diagonal();
+            return;
+        case 3:
+            board = BitBoard::flip_anti_diagonal(board);
+            reference = reference.flip_anti_diagonal();
+            return;
+        case 4:
+            board = BitBoard::rotate_clockwise(board);
+            reference = reference.rotate_clockwise();
+            return;
+        case 5:
+            board = BitBoard::rotate_half_turn(board);
+            reference = reference.rotate_half_turn();
+            return;
+        case 6:
+            board = BitBoard::rotate_counterclockwise(board);
+            reference = reference.rotate_counterclockwise();
+            return;
+        default:
+            board = BitBoard::canonical(board);
+            reference = reference.canonical();
+            return;
+        }
+    case Operation::combine: {
+        const auto kind = input.byte() % 4;
+        const BitBoard other{input.word()};
+        const ReferenceBoard other_reference{other};
+        switch (kind) {
+        case 0:
+            board |= other;
+            reference = reference | other_reference;
+            return;
+        case 1:
+            board &= other;
+            reference = reference & other_reference;
+            return;
+        case 2:
+            board ^= other;
+            reference = reference ^ other_reference;
+            return;
+        default:
+            board.clear(other);
+            reference = reference & ~other_reference;
+            return;
+        }
+    }
+    case Operation::set_square: {
+        const auto square = read_square(input);
+        check_throws_off_board(square, board, reference, [&](BitBoard& b, ReferenceBoard& r) {
+            b.set(square);
+            r.put(square.x(), square.y(), true);
+        });
+        return;
+    }
+    case Operation::clear_square: {
+        const auto square = read_square(input);
+        check_throws_off_board(square, board, reference, [&](BitBoard& b, ReferenceBoard& r) {
+            b.clear(square);
+            r.put(square.x(), square.y(), false);
+        });
+        return;
+    }
+    case Operation::parse: {
+        const auto text = read_board_text(input);
+        const auto parsed = ReferenceBoard::parse(text);
+        try {
+            const BitBoard board_from_text{text};
+            check(parsed.has_value(), "invalid string accepted", board_from_text, reference);
+            check(board_from_text == parsed->to_bitboard(), "string constructor", board_from_text, *parsed);
+            board = board_from_text;
+            reference = *parsed;
+        } catch (const std::invalid_argument&) {
+            check(!parsed.has_value(), "valid string rejected", board, reference);
+        }
+        return;
+    }
+    case Operation::complement:
+        board = ~board;
+        reference = ~reference;
+        return;
+    }
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, const std::size_t size)
+{
+    InputReader input{std::span{data, size}};
+    BitBoard board{input.word()};
+    ReferenceBoard reference{board};
+    check(reference.to_bitboard() == board, "reference round trip", board, reference);
+    while (!input.done()) {
+        const auto previous = board;
+        const auto operation = static_cast<Operation>(input.byte() % differential_operations);
+        apply(operation, input, board, reference);
+        check(board == reference.to_bitboard(), "board", board, reference);
+        check_queries(board, reference);
+        check_iteration(board, reference);
+        const Move base{previous.count() % BitBoard::n_bits, 0, static_cast<unsigned>(operation)};
+        check_kernels(board, reference, previous, base);
+    }
+    return 0;
+}
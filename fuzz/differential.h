@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Differential harness input: eight bytes of starting board (most significant first), then operations until the
+// input runs out. Each operation is one byte, taken modulo differential_operations, followed by the argument
+// bytes it needs; missing bytes read as zero. Every operation is applied to a BitBoard and to a ReferenceBoard,
+// and after each one the two must agree on the board, its queries, iteration order and the batch kernels of
+// every CPU level this machine supports. A disagreement prints both boards and aborts, which libFuzzer reports
+// as a crash.
+inline constexpr std::size_t differential_operations = 12;
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size);
@@ -0,0 +1,359 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The model the differential harness checks BitBoard against: one bool per square, indexed x * 8 + y, with
+// every operation written square by square from its definition rather than from bit tricks. Only the
+// conversions to and from BitBoard know that square i is bit 63 - i of the word.
+class ReferenceBoard
+{
+  public:
+    using Position = BitBoard::Position;
+    using Bits = BitBoard::Bits;
+
+    static constexpr int size = BitBoard::board_size;
+    static constexpr std::size_t n_squares = BitBoard::n_bits;
+
+    ReferenceBoard() = default;
+
+    explicit ReferenceBoard(const BitBoard board)
+    {
+        const auto bits = static_cast<Bits>(board.to_ullong());
+        for (std::size_t i = 0; i < n_squares; ++i) {
+            squares_[i] = ((bits >> (n_squares - 1 - i)) & 1) != 0;
+        }
+    }
+
+    [[nodiscard]] BitBoard to_bitboard() const
+    {
+        Bits bits = 0;
+        for (std::size_t i = 0; i < n_squares; ++i) {
+            if (squares_[i]) {
+                bits |= Bits{1} << (n_squares - 1 - i);
+            }
+        }
+        return BitBoard{bits};
+    }
+
+    [[nodiscard]] static bool on_board(const int x, const int y)
+    {
+        return x >= 0 && x < size && y >= 0 && y < size;
+    }
+
+    [[nodiscard]] bool get(const int x, const int y) const
+    {
+        return squares_[static_cast<std::size_t>(x * size + y)];
+    }
+
+    void put(const int x, const int y, const bool value)
+    {
+        squares_[static_cast<std::size_t>(x * size + y)] = value;
+    }
+
+    // Rows and columns one step in direction: up is towards row 0, left towards column 0.
+    [[nodiscard]] static int row_step(const Direction direction)
+    {
+        switch (direction) {
+        case upright:
+        case up:
+        case upleft:
+            return -1;
+        case downleft:
+        case down:
+        case downright:
+            return 1;
+        default:
+            return 0;
+        }
+    }
+
+    [[nodiscard]] static int column_step(const Direction direction)
+    {
+        switch (direction) {
+        case upleft:
+        case left:
+        case downleft:
+            return -1;
+        case upright:
+        case right:
+        case downright:
+            return 1;
+        default:
+            return 0;
+        }
+    }
+
+    // Every square moved dx rows and dy columns; squares that leave the board are dropped.
+    [[nodiscard]] ReferenceBoard shifted(const long dx, const long dy) const
+    {
+        ReferenceBoard result;
+        for (int x = 0; x < size; ++x) {
+            for (int y = 0; y < size; ++y) {
+                const auto to_x = x + dx;
+                const auto to_y = y + dy;
+                if (get(x, y) && to_x >= 0 && to_x < size && to_y >= 0 && to_y < size) {
+                    result.put(static_cast<int>(to_x), static_cast<int>(to_y), true);
+                }
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] ReferenceBoard shifted(const Direction direction, const std::size_t n) const
+    {
+        const auto steps = static_cast<long>(n);
+        return shifted(row_step(direction) * steps, column_step(direction) * steps);
+    }
+
+    // n rounds of adding the board shifted one step in direction.
+    [[nodiscard]] ReferenceBoard dilated(const Direction direction, const std::size_t n) const
+    {
+        auto result = *this;
+        for (std::size_t i = 0; i < n; ++i) {
+            result = result | result.shifted(direction, 1);
+        }
+        return result;
+    }
+
+    [[nodiscard]] ReferenceBoard neighbors(const bool cardinal, const bool diagonal) const
+    {
+        ReferenceBoard result;
+        for (const auto direction : {right, upright, up, upleft, left, downleft, down, downright}) {
+            const bool is_diagonal = row_step(direction) != 0 && column_step(direction) != 0;
+            if (is_diagonal ? diagonal : cardinal) {
+                result = result | shifted(direction, 1);
+            }
+        }
+        return result;
+    }
+
+    // The square (x, y) of the result is the square (map(x, y)) of this board.
+    template <typename Map>
+    [[nodiscard]] ReferenceBoard mapped(Map map) const
+    {
+        ReferenceBoard result;
+        for (int x = 0; x < size; ++x) {
+            for (int y = 0; y < size; ++y) {
+                const auto [from_x, from_y] = map(x, y);
+                result.put(x, y, get(from_x, from_y));
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] ReferenceBoard flip_vertical() const
+    {
+        return mapped([](const int x, const int y) { return std::array{size - 1 - x, y}; });
+    }
+    [[nodiscard]] ReferenceBoard flip_horizontal() const
+    {
+        return mapped([](const int x, const int y) { return std::array{x, size - 1 - y}; });
+    }
+    [[nodiscard]] ReferenceBoard flip_diagonal() const
+    {
+        return mapped([](const int x, const int y) { return std::array{y, x}; });
+    }
+    [[nodiscard]] ReferenceBoard flip_anti_diagonal() const
+    {
+        return mapped([](const int x, const int y) { return std::array{size - 1 - y, size - 1 - x}; });
+    }
+    // A quarter turn clockwise takes the top left corner to the top right.
+    [[nodiscard]] ReferenceBoard rotate_clockwise() const
+    {
+        return mapped([](const int x, const int y) { return std::array{size - 1 - y, x}; });
+    }
+    [[nodiscard]] ReferenceBoard rotate_half_turn() const
+    {
+        return mapped([](const int x, const int y) { return std::array{size - 1 - x, size - 1 - y}; });
+    }
+    [[nodiscard]] ReferenceBoard rotate_counterclockwise() const
+    {
+        return mapped([](const int x, const int y) { return std::array{y, size - 1 - x}; });
+    }
+
+    // The smallest of the eight symmetric boards in square order, which is BitBoard's numeric order.
+    [[nodiscard]] ReferenceBoard canonical() const
+    {
+        auto smallest = *this;
+        for (const auto& candidate :
+             {flip_vertical(), flip_horizontal(), rotate_half_turn(), flip_diagonal(), flip_anti_diagonal(),
+              rotate_clockwise(), rotate_counterclockwise()}) {
+            if (candidate.squares_ < smallest.squares_) {
+                smallest = candidate;
+            }
+        }
+        return smallest;
+    }
+
+    [[nodiscard]] std::size_t count() const
+    {
+        std::size_t n = 0;
+        for (const bool square : squares_) {
+            n += square ? 1 : 0;
+        }
+        return n;
+    }
+
+    // Whether any square lies on the edge or edges direction points to: upright is the top or the right edge.
+    [[nodiscard]] bool on_edge(const Direction direction) const
+    {
+        for (int x = 0; x < size; ++x) {
+            for (int y = 0; y < size; ++y) {
+                const bool edge = (row_step(direction) < 0 && x == 0) || (row_step(direction) > 0 && x == size - 1) ||
+                                  (column_step(direction) < 0 && y == 0) ||
+                                  (column_step(direction) > 0 && y == size - 1);
+                if (get(x, y) && edge) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] std::string to_string() const
+    {
+        std::string result;
+        for (const bool square : squares_) {
+            result += square ? '1' : '0';
+        }
+        return result;
+    }
+
+    // Nothing unless text is exactly 64 characters of '0' and '1'.
+    [[nodiscard]] static std::optional<ReferenceBoard> parse(const std::string_view text)
+    {
+        if (text.size() != n_squares) {
+            return std::nullopt;
+        }
+        ReferenceBoard result;
+        for (std::size_t i = 0; i < n_squares; ++i) {
+            if (text[i] != '0' && text[i] != '1') {
+                return std::nullopt;
+            }
+            result.squares_[i] = text[i] == '1';
+        }
+        return result;
+    }
+
+    // Set squares as (x, y), row by row.
+    [[nodiscard]] std::vector<Position> positions_by_row() const
+    {
+        std::vector<Position> result;
+        for (int x = 0; x < size; ++x) {
+            for (int y = 0; y < size; ++y) {
+                if (get(x, y)) {
+                    result.emplace_back(x, y);
+                }
+            }
+        }
+        return result;
+    }
+
+    // Set squares as (x, y), column by column.
+    [[nodiscard]] std::vector<Position> positions_by_column() const
+    {
+        std::vector<Position> result;
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                if (get(x, y)) {
+                    result.emplace_back(x, y);
+                }
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::vector<std::uint8_t> square_indices() const
+    {
+        std::vector<std::uint8_t> result;
+        for (std::size_t i = 0; i < n_squares; ++i) {
+            if (squares_[i]) {
+                result.push_back(static_cast<std::uint8_t>(i));
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] friend ReferenceBoard operator|(const ReferenceBoard& lhs, const ReferenceBoard& rhs)
+    {
+        return lhs.combined(rhs, [](const bool a, const bool b) { return a || b; });
+    }
+    [[nodiscard]] friend ReferenceBoard operator&(const ReferenceBoard& lhs, const ReferenceBoard& rhs)
+    {
+        return lhs.combined(rhs, [](const bool a, const bool b) { return a && b; });
+    }
+    [[nodiscard]] friend ReferenceBoard operator^(const ReferenceBoard& lhs, const ReferenceBoard& rhs)
+    {
+        return lhs.combined(rhs, [](const bool a, const bool b) { return a != b; });
+    }
+    [[nodiscard]] ReferenceBoard operator~() const
+    {
+        ReferenceBoard result;
+        for (std::size_t i = 0; i < n_squares; ++i) {
+            result.squares_[i] = !squares_[i];
+        }
+        return result;
+    }
+
+    [[nodiscard]] friend bool operator==(const ReferenceBoard& lhs, const ReferenceBoard& rhs) = default;
+
+  private:
+    std::array<bool, n_squares> squares_{};
+
+    template <typename Op>
+    [[nodiscard]] ReferenceBoard combined(const ReferenceBoard& other, Op op) const
+    {
+        ReferenceBoard result;
+        for (std::size_t i = 0; i < n_squares; ++i) {
+            result.squares_[i] = op(squares_[i], other.squares_[i]);
+        }
+        return result;
+    }
+};
+
+// Word-level reference for PEXT, PDEP and select: walk the bits from the least significant one by one.
+[[nodiscard]] inline BitBoard::Bits reference_extract_bits(const BitBoard::Bits bits, const BitBoard::Bits mask)
+{
+    BitBoard::Bits result = 0;
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < BitBoard::n_bits; ++i) {
+        if ((mask >> i) & 1) {
+            result |= ((bits >> i) & 1) << out++;
+        }
+    }
+    return result;
+}
+
+[[nodiscard]] inline BitBoard::Bits reference_deposit_bits(const BitBoard::Bits bits, const BitBoard::Bits mask)
+{
+    BitBoard::Bits result = 0;
+    std::size_t in = 0;
+    for (std::size_t i = 0; i < BitBoard::n_bits; ++i) {
+        if ((mask >> i) & 1) {
+            result |= ((bits >> in++) & 1) << i;
+        }
+    }
+    return result;
+}
+
+[[nodiscard]] inline BitBoard::Bits reference_select_bit(const BitBoard::Bits bits, const std::size_t n)
+{
+    std::size_t seen = 0;
+    for (std::size_t i = 0; i < BitBoard::n_bits; ++i) {
+        if ((bits >> i) & 1) {
+            if (seen++ == n) {
+                return BitBoard::Bits{1} << i;
+            }
+        }
+    }
+    return 0;
+}
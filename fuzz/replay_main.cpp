@@ -0,0 +1,224 @@
+// Runs the differential harness without libFuzzer: over edge-case inputs, over seeded random inputs and over
+// every file of a stored corpus. All inputs are loaded before the clock starts, so the reported rate measures
+// the harness and the library rather than the file system, and --min-rate turns the replay into a performance
+// gate. Prints one CSV row of statistics.
+//
+// usage: BitBoardFuzzReplay [--random N] [--seed S] [--max-length BYTES] [--repeat K] [--min-rate INPUTS_PER_S]
+//                           [--write-corpus DIR] [PATH...]
+
+#include "differential.h"
+
+#include "bit_board.h"
+#include "playout.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using Input = std::vector<std::uint8_t>;
+
+struct ReplayOptions
+{
+    std::size_t random_inputs{0};
+    std::uint64_t seed{1};
+    std::size_t max_length{256};
+    std::size_t repeat{1};
+    double min_rate{0};
+    std::filesystem::path write_corpus;
+    std::vector<std::filesystem::path> files;
+};
+
+std::vector<std::filesystem::path> collect_files(const std::filesystem::path& path)
+{
+    std::vector<std::filesystem::path> files;
+    if (std::filesystem::is_directory(path)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{path}) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else {
+        files.push_back(path);
+    }
+    return files;
+}
+
+ReplayOptions parse_options(const std::span<char*> args)
+{
+    ReplayOptions options;
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string_view arg{args[i]};
+        const auto value = [&] {
+            if (++i == args.size()) {
+                throw std::invalid_argument(std::string{arg} + " needs a value");
+            }
+            return std::string{args[i]};
+        };
+        if (arg == "--random") {
+            options.random_inputs = std::stoul(value());
+        } else if (arg == "--seed") {
+            options.seed = std::stoull(value());
+        } else if (arg == "--max-length") {
+            options.max_length = std::max<std::size_t>(sizeof(BitBoard::Bits), std::stoul(value()));
+        } else if (arg == "--repeat") {
+            options.repeat = std::stoul(value());
+        } else if (arg == "--min-rate") {
+            options.min_rate = std::stod(value());
+        } else if (arg == "--write-corpus") {
+            options.write_corpus = value();
+        } else {
+            const auto files = collect_files(std::filesystem::path{arg});
+            options.files.insert(options.files.end(), files.begin(), files.end());
+        }
+    }
+    return options;
+}
+
+void append_board(Input& input, const BitBoard board)
+{
+    const auto bits = static_cast<BitBoard::Bits>(board.to_ullong());
+    for (std::size_t i = sizeof(bits); i-- > 0;) {
+        input.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+    }
+}
+
+// Every operation with boundary argument bytes on boards that sit on edges, corners and diagonals.
+std::vector<Input> edge_case_inputs()
+{
+    const std::vector<BitBoard> boards{
+        BitBoard{},
+        BitBoard::make_full(),
+        BitBoard::make_all_edge(),
+        BitBoard::make_top_left(),
+        BitBoard::make_top_right(),
+        BitBoard::make_bottom_left(),
+        BitBoard::make_bottom_right(),
+        BitBoard::make_left_edge(),
+        BitBoard::make_right_edge(),
+        BitBoard::make_top_edge(),
+        BitBoard::make_bottom_edge(),
+        BitBoard::make_positive_slope(),
+        BitBoard::make_negative_slope(),
+        BitBoard{0xaa55aa55aa55aa55},
+        BitBoard{0x0123456789abcdef},
+        ~BitBoard::make_all_edge(),
+    };
+    const std::vector<std::uint8_t> arguments{0, 1, 2, 6, 7, 8, 9, 15, 16, 63, 64, 127, 128, 191, 192, 248, 255};
+    std::vector<Input> inputs;
+    for (const auto board : boards) {
+        for (std::size_t operation = 0; operation < differential_operations; ++operation) {
+            for (const auto first : arguments) {
+                for (const auto second : {std::uint8_t{0}, std::uint8_t{7}, std::uint8_t{255}}) {
+                    Input input;
+                    append_board(input, board);
+                    input.push_back(static_cast<std::uint8_t>(operation));
+                    input.push_back(first);
+                    // Enough argument bytes for the longest operation, a parse of a whole board.
+                    input.insert(input.end(), BitBoard::n_bits + 1, second);
+                    inputs.push_back(std::move(input));
+                }
+            }
+        }
+    }
+    return inputs;
+}
+
+std::vector<Input> random_inputs(const ReplayOptions& options)
+{
+    Xoshiro256 rng{options.seed};
+    std::vector<Input> inputs(options.random_inputs);
+    for (auto& input : inputs) {
+        const auto length = sizeof(BitBoard::Bits) + rng() % (options.max_length - sizeof(BitBoard::Bits) + 1);
+        input.resize(length);
+        for (auto& byte : input) {
+            byte = static_cast<std::uint8_t>(rng());
+        }
+    }
+    return inputs;
+}
+
+Input read_file(const std::filesystem::path& path)
+{
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        throw std::runtime_error("cannot open " + path.string());
+    }
+    return Input{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+// Names are the input's position in the replay, so rewriting a corpus with the same options gives the same files.
+void write_corpus(const std::filesystem::path& directory, const std::vector<Input>& inputs)
+{
+    std::filesystem::create_directories(directory);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        std::ostringstream name;
+        name << "input-" << i;
+        std::ofstream out{directory / name.str(), std::ios::binary};
+        out.write(reinterpret_cast<const char*>(inputs[i].data()), static_cast<std::streamsize>(inputs[i].size()));
+        if (!out) {
+            throw std::runtime_error("cannot write " + (directory / name.str()).string());
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        const auto options = parse_options(std::span{argv + 1, static_cast<std::size_t>(argc - 1)});
+
+        auto inputs = edge_case_inputs();
+        const auto generated = random_inputs(options);
+        inputs.insert(inputs.end(), generated.begin(), generated.end());
+        if (!options.write_corpus.empty()) {
+            write_corpus(options.write_corpus, inputs);
+        }
+        for (const auto& file : options.files) {
+            inputs.push_back(read_file(file));
+        }
+        std::size_t bytes = 0;
+        for (const auto& input : inputs) {
+            bytes += input.size();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t round = 0; round < options.repeat; ++round) {
+            for (const auto& input : inputs) {
+                LLVMFuzzerTestOneInput(input.data(), input.size());
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        const auto replayed = static_cast<double>(inputs.size() * options.repeat);
+        const auto seconds = std::max(elapsed.count(), 1e-9);
+        const auto rate = replayed / seconds;
+        std::cout << "inputs,corpus_files,bytes,repeat,seconds,inputs_per_second,megabytes_per_second\n"
+                  << inputs.size() << ',' << options.files.size() << ',' << bytes << ',' << options.repeat << ','
+                  << seconds << ',' << rate << ','
+                  << static_cast<double>(bytes * options.repeat) / seconds / 1e6 << '\n';
+        if (rate < options.min_rate) {
+            std::cerr << "replay rate " << rate << " inputs/s is below --min-rate " << options.min_rate << '\n';
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "BitBoardFuzzReplay: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
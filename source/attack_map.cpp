@@ -0,0 +1,273 @@
+#include "attack_map.h"
+
+#include "bit_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <bit>
+#include <stdexcept>
+
+namespace {
+
+using Bits = BitBoard::Bits;
+
+constexpr std::size_t n_squares = BitBoard::n_bits;
+constexpr std::size_t n_directions = 8;
+constexpr std::uint8_t no_direction = n_directions;
+
+// Row and column step of each Direction, in enum order.
+constexpr std::array<int, n_directions> row_steps{0, -1, -1, -1, 0, 1, 1, 1};
+constexpr std::array<int, n_directions> column_steps{1, 1, 0, -1, -1, -1, 0, 1};
+
+constexpr Bits square_bit(const std::size_t square) noexcept
+{
+    return Bits{1} << (n_squares - 1 - square);
+}
+
+struct RayTables
+{
+    std::array<std::array<Bits, n_directions>, n_squares> rays;
+    std::array<std::array<Bits, n_squares>, n_squares> between;
+    std::array<std::array<std::uint8_t, n_squares>, n_squares> directions;
+};
+
+constexpr RayTables make_ray_tables()
+{
+    RayTables tables{};
+    for (auto& row : tables.directions) {
+        row.fill(no_direction);
+    }
+    for (std::size_t square = 0; square < n_squares; ++square) {
+        for (std::size_t direction = 0; direction < n_directions; ++direction) {
+            Bits passed = 0;
+            int x = static_cast<int>(square) / BitBoard::board_size + row_steps[direction];
+            int y = static_cast<int>(square) % BitBoard::board_size + column_steps[direction];
+            for (; x >= 0 && x < BitBoard::board_size && y >= 0 && y < BitBoard::board_size;
+                 x += row_steps[direction], y += column_steps[direction]) {
+                const auto target = static_cast<std::size_t>(x * BitBoard::board_size + y);
+                tables.between[square][target] = passed;
+                tables.directions[square][target] = static_cast<std::uint8_t>(direction);
+                passed |= square_bit(target);
+            }
+            tables.rays[square][direction] = passed;
+        }
+    }
+    return tables;
+}
+
+constexpr RayTables ray_tables = make_ray_tables();
+
+// Directions that walk towards higher square indices, i.e. towards less significant bits.
+constexpr bool increasing(const std::size_t direction) noexcept
+{
+    return direction == right || direction == downleft || direction == down || direction == downright;
+}
+
+constexpr bool slides(const AttackPattern pattern, const std::size_t direction) noexcept
+{
+    switch (pattern) {
+    case AttackPattern::cardinal_slider:
+        return direction % 2 == 0;
+    case AttackPattern::diagonal_slider:
+        return direction % 2 == 1;
+    case AttackPattern::cardinal_and_diagonal_slider:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Bits ray_attacks(const std::size_t square, const std::size_t direction, const Bits occupancy) noexcept
+{
+    const Bits ray = ray_tables.rays[square][direction];
+    const Bits blockers = ray & occupancy;
+    if (blockers == 0) {
+        return ray;
+    }
+    const auto nearest = increasing(direction) ? static_cast<std::size_t>(std::countl_zero(blockers))
+                                               : n_squares - 1 - static_cast<std::size_t>(std::countr_zero(blockers));
+    return ray ^ ray_tables.rays[nearest][direction];
+}
+
+Bits compute_attacks(const std::size_t square, const AttackPattern pattern, const Bits occupancy) noexcept
+{
+    if (pattern == AttackPattern::step) {
+        return BitBoard::neighbors_cardinal_and_diagonal(BitBoard{square_bit(square)}).to_ullong();
+    }
+    Bits attacks = 0;
+    for (std::size_t direction = 0; direction < n_directions; ++direction) {
+        if (slides(pattern, direction)) {
+            attacks |= ray_attacks(square, direction, occupancy);
+        }
+    }
+    return attacks;
+}
+
+std::size_t square_index(const BitBoard::Position& position)
+{
+    if (position.x() < 0 || position.x() >= BitBoard::board_size || position.y() < 0 ||
+        position.y() >= BitBoard::board_size) {
+        throw std::invalid_argument("position outside of board");
+    }
+    return static_cast<std::size_t>(position.x() * BitBoard::board_size + position.y());
+}
+
+template <typename F>
+void for_each_square(Bits bits, F&& f)
+{
+    while (bits != 0) {
+        const auto square = static_cast<std::size_t>(std::countl_zero(bits));
+        bits &= ~square_bit(square);
+        f(square);
+    }
+}
+
+} // namespace
+
+BitBoard ray(const BitBoard::Position& position, const Direction direction)
+{
+    return BitBoard{ray_tables.rays[square_index(position)][direction]};
+}
+
+BitBoard between(const BitBoard::Position& from, const BitBoard::Position& to)
+{
+    return BitBoard{ray_tables.between[square_index(from)][square_index(to)]};
+}
+
+BitBoard attacks_from(const BitBoard::Position& position, const AttackPattern pattern, const BitBoard occupancy)
+{
+    return BitBoard{compute_attacks(square_index(position), pattern, occupancy.to_ullong())};
+}
+
+AttackMap::AttackMap() noexcept : patterns_{} {}
+
+void AttackMap::place(const Position& position, const AttackPattern pattern)
+{
+    const auto square = square_index(position);
+    if (pattern == AttackPattern::none) {
+        throw std::invalid_argument("cannot place an empty attack pattern");
+    }
+    if (patterns_[square] != AttackPattern::none) {
+        throw std::invalid_argument("square already occupied");
+    }
+    place_square(square, pattern);
+}
+
+void AttackMap::remove(const Position& position)
+{
+    const auto square = square_index(position);
+    if (patterns_[square] == AttackPattern::none) {
+        throw std::invalid_argument("square is empty");
+    }
+    remove_square(square);
+}
+
+AttackMap::Undo AttackMap::make_move(const Position& from, const Position& to)
+{
+    const auto from_square = square_index(from);
+    const auto to_square = square_index(to);
+    if (patterns_[from_square] == AttackPattern::none) {
+        throw std::invalid_argument("no piece to move");
+    }
+    if (from_square == to_square) {
+        throw std::invalid_argument("move must change square");
+    }
+    const Undo undo{
+        static_cast<std::uint8_t>(from_square),
+        static_cast<std::uint8_t>(to_square),
+        patterns_[from_square],
+        patterns_[to_square],
+    };
+    if (undo.captured != AttackPattern::none) {
+        remove_square(to_square);
+    }
+    remove_square(from_square);
+    place_square(to_square, undo.moved);
+    return undo;
+}
+
+void AttackMap::unmake_move(const Undo& undo) noexcept
+{
+    remove_square(undo.to);
+    place_square(undo.from, undo.moved);
+    if (undo.captured != AttackPattern::none) {
+        place_square(undo.to, undo.captured);
+    }
+}
+
+void AttackMap::rebuild() noexcept
+{
+    attacks_.fill(BitBoard{});
+    attackers_.fill(BitBoard{});
+    for_each_square(occupancy_.to_ullong(), [&](const std::size_t square) {
+        add_attacks(square, BitBoard{compute_attacks(square, patterns_[square], occupancy_.to_ullong())});
+    });
+}
+
+AttackPattern AttackMap::pattern(const Position& position) const
+{
+    return patterns_[square_index(position)];
+}
+
+BitBoard AttackMap::attacks(const Position& position) const
+{
+    return attacks_[square_index(position)];
+}
+
+BitBoard AttackMap::attackers(const Position& position) const
+{
+    return attackers_[square_index(position)];
+}
+
+BitBoard AttackMap::attacked() const noexcept
+{
+    BitBoard attacked{};
+    for_each_square(occupancy_.to_ullong(), [&](const std::size_t square) { attacked |= attacks_[square]; });
+    return attacked;
+}
+
+void AttackMap::place_square(const std::size_t square, const AttackPattern pattern) noexcept
+{
+    // The new piece cuts every ray passing through its square.
+    for_each_square(attackers_[square].to_ullong(), [&](const std::size_t slider) {
+        if (patterns_[slider] != AttackPattern::step) {
+            const auto direction = ray_tables.directions[slider][square];
+            remove_attacks(slider, attacks_[slider] & BitBoard{ray_tables.rays[square][direction]});
+        }
+    });
+    occupancy_.set(BitBoard{square_bit(square)});
+    patterns_[square] = pattern;
+    add_attacks(square, BitBoard{compute_attacks(square, pattern, occupancy_.to_ullong())});
+}
+
+void AttackMap::remove_square(const std::size_t square) noexcept
+{
+    remove_attacks(square, attacks_[square]);
+    occupancy_.clear(BitBoard{square_bit(square)});
+    patterns_[square] = AttackPattern::none;
+    // Rays that stopped on this square now continue to the next blocker.
+    for_each_square(attackers_[square].to_ullong(), [&](const std::size_t slider) {
+        if (patterns_[slider] != AttackPattern::step) {
+            const auto direction = ray_tables.directions[slider][square];
+            add_attacks(slider, BitBoard{ray_attacks(square, direction, occupancy_.to_ullong())});
+        }
+    });
+}
+
+void AttackMap::add_attacks(const std::size_t square, const BitBoard targets) noexcept
+{
+    attacks_[square] |= targets;
+    for_each_square(targets.to_ullong(), [&](const std::size_t target) {
+        attackers_[target] |= BitBoard{square_bit(square)};
+    });
+}
+
+void AttackMap::remove_attacks(const std::size_t square, const BitBoard targets) noexcept
+{
+    attacks_[square] &= ~targets;
+    for_each_square(targets.to_ullong(), [&](const std::size_t target) {
+        attackers_[target] &= ~BitBoard{square_bit(square)};
+    });
+}
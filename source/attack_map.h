@@ -0,0 +1,77 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+
+enum class AttackPattern : std::uint8_t
+{
+    none,
+    cardinal_slider,
+    diagonal_slider,
+    cardinal_and_diagonal_slider,
+    step,
+};
+
+// Squares from position to the edge in the given direction, excluding position.
+[[nodiscard]] BitBoard ray(const BitBoard::Position& position, Direction direction);
+
+// Squares strictly between two squares on a common rank, file or diagonal; empty if they share no line.
+[[nodiscard]] BitBoard between(const BitBoard::Position& from, const BitBoard::Position& to);
+
+// Squares attacked from position with the given occupancy, computed from scratch.
+[[nodiscard]] BitBoard attacks_from(const BitBoard::Position& position, AttackPattern pattern, BitBoard occupancy);
+
+// Attack sets kept up to date as pieces are placed and removed. Each square records which squares its piece
+// attacks and which squares attack it, so a change only revisits the sliders whose rays pass through it.
+class AttackMap
+{
+  public:
+    using Position = BitBoard::Position;
+
+    // Everything needed to take a move back; unmake_move() restores the map exactly.
+    struct Undo
+    {
+        std::uint8_t from;
+        std::uint8_t to;
+        AttackPattern moved;
+        AttackPattern captured;
+    };
+
+    explicit AttackMap() noexcept;
+
+    void place(const Position& position, AttackPattern pattern);
+    void remove(const Position& position);
+
+    // Moves the piece on from to to, capturing whatever stands there.
+    [[nodiscard]] Undo make_move(const Position& from, const Position& to);
+    void unmake_move(const Undo& undo) noexcept;
+
+    // Recomputes every attack set from the occupancy, discarding the incremental state.
+    void rebuild() noexcept;
+
+    [[nodiscard]] BitBoard occupancy() const noexcept
+    {
+        return occupancy_;
+    }
+    [[nodiscard]] AttackPattern pattern(const Position& position) const;
+    [[nodiscard]] BitBoard attacks(const Position& position) const;
+    [[nodiscard]] BitBoard attackers(const Position& position) const;
+    [[nodiscard]] BitBoard attacked() const noexcept;
+
+    [[nodiscard]] friend bool operator==(const AttackMap& lhs, const AttackMap& rhs) noexcept = default;
+
+  private:
+    std::array<BitBoard, BitBoard::n_bits> attacks_;
+    std::array<BitBoard, BitBoard::n_bits> attackers_;
+    std::array<AttackPattern, BitBoard::n_bits> patterns_;
+    BitBoard occupancy_;
+
+    void place_square(std::size_t square, AttackPattern pattern) noexcept;
+    void remove_square(std::size_t square) noexcept;
+    void add_attacks(std::size_t square, BitBoard targets) noexcept;
+    void remove_attacks(std::size_t square, BitBoard targets) noexcept;
+};
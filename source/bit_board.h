@@ -1,5 +1,6 @@
 #pragma once
 
+#include "instrumentation.h"
 #include "vec2.h"
 
 #include <cassert>
@@ -7,7 +8,13 @@
 #include <cstdint>
 
 #include <bit>
+#include <iterator>
+#include <memory_resource>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 enum Direction
@@ -22,6 +29,14 @@ enum Direction
     downright,
 };
 
+// A relative offset known at compile time, dx rows down and dy columns right, as in shift(board, Position).
+template <int DX, int DY>
+struct Offset
+{
+    static constexpr int dx = DX;
+    static constexpr int dy = DY;
+};
+
 class BitBoard
 {
   public:
@@ -35,7 +50,7 @@ class BitBoard
     constexpr explicit BitBoard() noexcept : BitBoard(0) {}
     constexpr explicit BitBoard(const Bits bits) noexcept : bits_(bits) {}
     constexpr explicit BitBoard(const Position& position) : BitBoard(from_position(position)) {}
-    explicit BitBoard(const std::string& board);
+    constexpr explicit BitBoard(std::string_view board);
 
     constexpr BitBoard(const BitBoard& other) = default;
     constexpr BitBoard& operator=(const BitBoard&) = default;
@@ -115,38 +130,70 @@ class BitBoard
     {
         return BitBoard::shift<Direction::right>(make_left_edge(), n);
     }
+    template <std::size_t N>
+    static constexpr BitBoard make_row() noexcept
+    {
+        return BitBoard::shift<Direction::down, N>(make_top_edge());
+    }
+    template <std::size_t N>
+    static constexpr BitBoard make_column() noexcept
+    {
+        return BitBoard::shift<Direction::right, N>(make_left_edge());
+    }
 
     template <Direction D>
     [[nodiscard]] static constexpr BitBoard shift(BitBoard board, const size_t n = 1)
     {
         return board.shift_assign<D>(n);
     }
-    [[nodiscard]] static BitBoard shift(BitBoard board, Direction direction, size_t n = 1);
-    [[nodiscard]] static BitBoard shift(BitBoard board, Position relative_offset);
+    [[nodiscard]] static constexpr BitBoard shift(BitBoard board, Direction direction, size_t n = 1);
+    [[nodiscard]] static constexpr BitBoard shift(BitBoard board, Position relative_offset);
 
-    static BitBoard neighbors_cardinal(BitBoard position) noexcept;
-    static BitBoard neighbors_cardinal(const Position& position) noexcept;
-    static BitBoard neighbors_diagonal(BitBoard position) noexcept;
-    static BitBoard neighbors_diagonal(const Position& position) noexcept;
-    static BitBoard neighbors_cardinal_and_diagonal(BitBoard position) noexcept;
-    static BitBoard neighbors_cardinal_and_diagonal(const Position& position) noexcept;
+    // Shifts with the amount known at compile time: one shift and one constant mask, whatever the direction.
+    template <Direction D, std::size_t N>
+    [[nodiscard]] static constexpr BitBoard shift(const BitBoard board) noexcept
+    {
+        constexpr auto n = static_cast<int>(N);
+        return shift(board, Offset<row_step(D) * n, column_step(D) * n>{});
+    }
+    template <int DX, int DY>
+    [[nodiscard]] static constexpr BitBoard shift(const BitBoard board, Offset<DX, DY>) noexcept
+    {
+        return BitBoard{shift_bits<DX, DY>(board.bits_)};
+    }
 
-    [[nodiscard]] bool test(const Position& position) const noexcept
+    static constexpr BitBoard neighbors_cardinal(BitBoard position) noexcept;
+    static constexpr BitBoard neighbors_cardinal(const Position& position) noexcept;
+    static constexpr BitBoard neighbors_diagonal(BitBoard position) noexcept;
+    static constexpr BitBoard neighbors_diagonal(const Position& position) noexcept;
+    static constexpr BitBoard neighbors_cardinal_and_diagonal(BitBoard position) noexcept;
+    static constexpr BitBoard neighbors_cardinal_and_diagonal(const Position& position) noexcept;
+
+    [[nodiscard]] static constexpr BitBoard flip_vertical(BitBoard board) noexcept;
+    [[nodiscard]] static constexpr BitBoard flip_horizontal(BitBoard board) noexcept;
+    [[nodiscard]] static constexpr BitBoard flip_diagonal(BitBoard board) noexcept;
+    [[nodiscard]] static constexpr BitBoard flip_anti_diagonal(BitBoard board) noexcept;
+    [[nodiscard]] static constexpr BitBoard rotate_clockwise(BitBoard board) noexcept;
+    [[nodiscard]] static constexpr BitBoard rotate_half_turn(BitBoard board) noexcept;
+    [[nodiscard]] static constexpr BitBoard rotate_counterclockwise(BitBoard board) noexcept;
+    [[nodiscard]] static constexpr BitBoard canonical(BitBoard board) noexcept;
+
+    [[nodiscard]] constexpr bool test(const Position& position) const noexcept
     {
         return test_any(BitBoard{position});
     }
 
-    [[nodiscard]] bool test_any(const BitBoard other) const noexcept
+    [[nodiscard]] constexpr bool test_any(const BitBoard other) const noexcept
     {
         return !(*this & other).empty();
     }
 
-    [[nodiscard]] bool test_all(const BitBoard other) const noexcept
+    [[nodiscard]] constexpr bool test_all(const BitBoard other) const noexcept
     {
         return (*this & other) == other;
     }
 
-    [[nodiscard]] bool empty() const noexcept
+    [[nodiscard]] constexpr bool empty() const noexcept
     {
         return bits_ == 0U;
     }
@@ -161,56 +208,62 @@ class BitBoard
         return std::has_single_bit(bits_);
     }
 
-    BitBoard& set(const BitBoard other) noexcept
+    constexpr BitBoard& set(const BitBoard other) noexcept
     {
         bits_ |= other.bits_;
         return *this;
     }
 
-    BitBoard& set(const Position& position)
+    constexpr BitBoard& set(const Position& position)
     {
         return set(BitBoard{position});
     }
 
-    BitBoard& clear(const BitBoard other) noexcept
+    constexpr BitBoard& clear(const BitBoard other) noexcept
     {
         *this &= ~other;
         return *this;
     }
 
-    BitBoard& clear(const Position& position)
+    constexpr BitBoard& clear(const Position& position)
     {
         return clear(BitBoard{position});
     }
 
-    BitBoard& clear_all() noexcept
+    constexpr BitBoard& clear_all() noexcept
     {
         bits_ = 0U;
         return *this;
     }
 
     template <Direction D>
-    [[nodiscard]] bool on_edge() const noexcept;
+    [[nodiscard]] constexpr bool on_edge() const noexcept;
 
-    [[nodiscard]] bool on_edge(Direction direction) const noexcept;
+    [[nodiscard]] constexpr bool on_edge(Direction direction) const noexcept;
 
-    [[nodiscard]] bool on_any_edge() const noexcept;
+    [[nodiscard]] constexpr bool on_any_edge() const noexcept;
 
     template <Direction D>
     constexpr BitBoard& shift_assign(size_t n = 1) noexcept;
 
-    BitBoard& shift_assign(Direction direction, size_t n = 1) noexcept;
+    constexpr BitBoard& shift_assign(Direction direction, size_t n = 1) noexcept;
+
+    constexpr BitBoard& shift_assign(Position relative_offset) noexcept;
 
-    BitBoard& shift_assign(Position relative_offset) noexcept;
+    template <Direction D, std::size_t N>
+    constexpr BitBoard& shift_assign() noexcept
+    {
+        return *this = BitBoard::shift<D, N>(*this);
+    }
 
     template <Direction D>
-    BitBoard& dilate() noexcept
+    constexpr BitBoard& dilate() noexcept
     {
         return *this |= BitBoard::shift<D>(*this);
     }
 
     template <Direction D>
-    BitBoard& dilate(const size_t n) noexcept
+    constexpr BitBoard& dilate(const size_t n) noexcept
     {
         for (size_t i = 0; i < n; i++) {
             dilate<D>();
@@ -218,7 +271,16 @@ class BitBoard
         return *this;
     }
 
-    BitBoard& dilate(Direction direction, size_t n = 1) noexcept;
+    template <Direction D, std::size_t N>
+    constexpr BitBoard& dilate() noexcept
+    {
+        for (std::size_t i = 0; i < N; i++) {
+            *this |= BitBoard::shift<D, 1>(*this);
+        }
+        return *this;
+    }
+
+    constexpr BitBoard& dilate(Direction direction, size_t n = 1) noexcept;
 
     [[nodiscard]] constexpr unsigned long long to_ullong() const
     {
@@ -231,6 +293,21 @@ class BitBoard
 
     [[nodiscard]] std::string to_string() const noexcept;
 
+    [[nodiscard]] std::pmr::vector<Position> to_position_vector(std::pmr::memory_resource* resource) const;
+    [[nodiscard]] std::pmr::vector<BitBoard> to_bitboard_vector(std::pmr::memory_resource* resource) const;
+    [[nodiscard]] std::pmr::set<Position> to_position_set(std::pmr::memory_resource* resource) const;
+    [[nodiscard]] std::pmr::string to_string(std::pmr::memory_resource* resource) const;
+
+    // Non-allocating forms: write the same sequence as the container forms and return the advanced iterator.
+    template <std::output_iterator<Position> Out>
+    constexpr Out to_position_vector(Out out) const;
+    template <std::output_iterator<BitBoard> Out>
+    constexpr Out to_bitboard_vector(Out out) const;
+    template <std::output_iterator<Position> Out>
+    constexpr Out to_position_set(Out out) const;
+    template <std::output_iterator<char> Out>
+    constexpr Out to_string(Out out) const;
+
     constexpr BitBoard& operator<<=(size_t n)
     {
         bits_ <<= n;
@@ -330,7 +407,49 @@ class BitBoard
     inline static constexpr Position index_to_position(std::size_t index) noexcept;
     inline static constexpr std::size_t position_to_index(const Position& position) noexcept;
 
-    friend void swap(BitBoard& lhs, BitBoard& rhs)
+    static constexpr int row_step(const Direction direction) noexcept
+    {
+        return direction == upright || direction == up || direction == upleft         ? -1
+               : direction == downleft || direction == down || direction == downright ? 1
+                                                                                      : 0;
+    }
+    static constexpr int column_step(const Direction direction) noexcept
+    {
+        return direction == upleft || direction == left || direction == downleft      ? -1
+               : direction == upright || direction == right || direction == downright ? 1
+                                                                                      : 0;
+    }
+
+    // Squares in columns first to last, inclusive.
+    static constexpr Bits columns(const int first, const int last) noexcept
+    {
+        Bits mask{0};
+        for (int column = first; column <= last; column++) {
+            mask |= left_edge >> column;
+        }
+        return mask;
+    }
+
+    // Moving a square dx rows and dy columns moves its index by dx * 8 + dy, so the whole offset is one shift.
+    // Squares that would leave the board through the top or bottom fall off the word; those that would leave
+    // through a side wrap into the columns the mask clears.
+    template <int DX, int DY>
+    static constexpr Bits shift_bits(const Bits bits) noexcept
+    {
+        if constexpr (DX <= -board_size || DX >= board_size || DY <= -board_size || DY >= board_size) {
+            return 0;
+        } else {
+            constexpr int amount = DX * board_size + DY;
+            constexpr Bits mask = columns(DY > 0 ? DY : 0, DY < 0 ? board_size - 1 + DY : board_size - 1);
+            if constexpr (amount >= 0) {
+                return (bits >> amount) & mask;
+            } else {
+                return (bits << -amount) & mask;
+            }
+        }
+    }
+
+    constexpr friend void swap(BitBoard& lhs, BitBoard& rhs)
     {
         std::swap(lhs.bits_, rhs.bits_);
     }
@@ -347,6 +466,7 @@ constexpr BitBoard BitBoard::from_index(const std::size_t index)
 constexpr BitBoard BitBoard::from_position(const Position& position)
 {
     if (position.x() < 0 || position.x() >= board_size || position.y() < 0 || position.y() >= board_size) {
+        BITBOARD_COUNT(Probe::from_position_error);
         throw std::invalid_argument("position outside of board");
     }
     return from_index(position_to_index(position));
@@ -358,6 +478,50 @@ constexpr BitBoard::Position BitBoard::to_position() const
     return index_to_position(std::countl_zero(bits_));
 }
 
+template <std::output_iterator<BitBoard::Position> Out>
+constexpr Out BitBoard::to_position_vector(Out out) const
+{
+    using T = Position::dimension_type;
+    // Column-major order is row-major order of the transposed board.
+    for (Bits bits = flip_diagonal(*this).bits_; bits != 0;) {
+        const auto index = static_cast<std::size_t>(std::countl_zero(bits));
+        bits &= ~(top_left >> index);
+        *out++ = Position{static_cast<T>(index % board_size), static_cast<T>(index / board_size)};
+    }
+    return out;
+}
+
+template <std::output_iterator<BitBoard> Out>
+constexpr Out BitBoard::to_bitboard_vector(Out out) const
+{
+    for (Bits bits = bits_; bits != 0;) {
+        const auto square = top_left >> std::countl_zero(bits);
+        bits &= ~square;
+        *out++ = BitBoard{square};
+    }
+    return out;
+}
+
+template <std::output_iterator<BitBoard::Position> Out>
+constexpr Out BitBoard::to_position_set(Out out) const
+{
+    for (Bits bits = bits_; bits != 0;) {
+        const auto index = static_cast<std::size_t>(std::countl_zero(bits));
+        bits &= ~(top_left >> index);
+        *out++ = index_to_position(index);
+    }
+    return out;
+}
+
+template <std::output_iterator<char> Out>
+constexpr Out BitBoard::to_string(Out out) const
+{
+    for (std::size_t index = 0; index < n_bits; ++index) {
+        *out++ = (bits_ & (top_left >> index)) != 0 ? '1' : '0';
+    }
+    return out;
+}
+
 constexpr std::size_t BitBoard::position_to_index(const Position& position) noexcept
 {
     return position.x() * board_size + position.y();
@@ -372,18 +536,23 @@ constexpr BitBoard::Position BitBoard::index_to_position(const std::size_t index
 template <>
 constexpr BitBoard& BitBoard::shift_assign<Direction::up>(const size_t n) noexcept
 {
-    bits_ <<= (board_size * n);
+    // Shifting a word by its width or more is undefined; every square has left the board by then.
+    bits_ = n < static_cast<size_t>(board_size) ? bits_ << (board_size * n) : 0;
     return *this;
 }
 template <>
 constexpr BitBoard& BitBoard::shift_assign<Direction::down>(const size_t n) noexcept
 {
-    bits_ >>= (board_size * n);
+    bits_ = n < static_cast<size_t>(board_size) ? bits_ >> (board_size * n) : 0;
     return *this;
 }
 template <>
 constexpr BitBoard& BitBoard::shift_assign<Direction::left>(const size_t n) noexcept
 {
+    if (n >= static_cast<size_t>(board_size)) {
+        bits_ = 0;
+        return *this;
+    }
     Bits wall{0};
     for (size_t i = 0; i < n; i++) {
         wall |= (right_edge << i);
@@ -395,6 +564,10 @@ constexpr BitBoard& BitBoard::shift_assign<Direction::left>(const size_t n) noex
 template <>
 constexpr BitBoard& BitBoard::shift_assign<Direction::right>(const size_t n) noexcept
 {
+    if (n >= static_cast<size_t>(board_size)) {
+        bits_ = 0;
+        return *this;
+    }
     Bits wall{0};
     for (size_t i = 0; i < n; i++) {
         wall |= (left_edge >> i);
@@ -423,3 +596,295 @@ constexpr BitBoard& BitBoard::shift_assign<Direction::downleft>(const size_t n)
 {
     return shift_assign<Direction::down>(n).shift_assign<Direction::left>(n);
 }
+
+constexpr BitBoard::BitBoard(const std::string_view board) : bits_{0}
+{
+    BITBOARD_COUNT(Probe::string_constructor);
+    if (board.length() != n_bits) {
+        throw std::invalid_argument("invalid string length");
+    }
+
+    for (size_t i = 0; i < board.length(); ++i) {
+        if (board[i] == '1') {
+            bits_ |= (top_left >> i);
+        } else if (board[i] != '0') {
+            throw std::invalid_argument("invalid string character");
+        }
+    }
+}
+
+template <>
+constexpr bool BitBoard::on_edge<right>() const noexcept
+{
+    return test_any(make_right_edge());
+}
+
+template <>
+constexpr bool BitBoard::on_edge<upright>() const noexcept
+{
+    return test_any(make_top_right_edge());
+}
+
+template <>
+constexpr bool BitBoard::on_edge<up>() const noexcept
+{
+    return test_any(make_top_edge());
+}
+
+template <>
+constexpr bool BitBoard::on_edge<upleft>() const noexcept
+{
+    return test_any(make_top_left_edge());
+}
+
+template <>
+constexpr bool BitBoard::on_edge<left>() const noexcept
+{
+    return test_any(make_left_edge());
+}
+
+template <>
+constexpr bool BitBoard::on_edge<downright>() const noexcept
+{
+    return test_any(make_bottom_right_edge());
+}
+
+template <>
+constexpr bool BitBoard::on_edge<down>() const noexcept
+{
+    return test_any(make_bottom_edge());
+}
+
+template <>
+constexpr bool BitBoard::on_edge<downleft>() const noexcept
+{
+    return test_any(make_bottom_left_edge());
+}
+
+constexpr bool BitBoard::on_edge(const Direction direction) const noexcept
+{
+    BITBOARD_COUNT(Probe::on_edge_dynamic);
+    switch (direction) {
+    case right:
+        return on_edge<right>();
+    case upright:
+        return on_edge<upright>();
+    case up:
+        return on_edge<up>();
+    case upleft:
+        return on_edge<upleft>();
+    case left:
+        return on_edge<left>();
+    case downleft:
+        return on_edge<downleft>();
+    case down:
+        return on_edge<down>();
+    case downright:
+        return on_edge<downright>();
+    default:
+        assert(!"invalid direction");
+        return {};
+    }
+}
+
+constexpr bool BitBoard::on_any_edge() const noexcept
+{
+    BITBOARD_COUNT(Probe::on_any_edge);
+    return test_any(make_all_edge());
+}
+
+constexpr BitBoard BitBoard::shift(BitBoard board, const Direction direction, const size_t n)
+{
+    return board.shift_assign(direction, n);
+}
+
+constexpr BitBoard BitBoard::shift(BitBoard board, Position relative_offset)
+{
+    return board.shift_assign(relative_offset);
+}
+
+constexpr BitBoard& BitBoard::dilate(const Direction direction, const size_t n) noexcept
+{
+    BITBOARD_COUNT(Probe::dilate_dynamic);
+    switch (direction) {
+    case right:
+        return dilate<right>(n);
+    case upright:
+        return dilate<upright>(n);
+    case up:
+        return dilate<up>(n);
+    case upleft:
+        return dilate<upleft>(n);
+    case left:
+        return dilate<left>(n);
+    case downleft:
+        return dilate<downleft>(n);
+    case down:
+        return dilate<down>(n);
+    case downright:
+        return dilate<downright>(n);
+    }
+    assert(!"invalid direction");
+    return *this;
+}
+
+constexpr BitBoard& BitBoard::shift_assign(const Direction direction, const size_t n) noexcept
+{
+    BITBOARD_COUNT(Probe::shift_dynamic);
+    switch (direction) {
+    case right:
+        return shift_assign<right>(n);
+    case upright:
+        return shift_assign<upright>(n);
+    case up:
+        return shift_assign<up>(n);
+    case upleft:
+        return shift_assign<upleft>(n);
+    case left:
+        return shift_assign<left>(n);
+    case downleft:
+        return shift_assign<downleft>(n);
+    case down:
+        return shift_assign<down>(n);
+    case downright:
+        return shift_assign<downright>(n);
+    }
+    assert(!"invalid direction");
+    return *this;
+}
+
+constexpr BitBoard& BitBoard::shift_assign(const BitBoard::Position relative_offset) noexcept
+{
+    BITBOARD_COUNT(Probe::shift_offset);
+    if (relative_offset.x() >= 0) {
+        shift_assign<Direction::down>(relative_offset.x());
+    } else {
+        shift_assign<Direction::up>(-relative_offset.x());
+    }
+    if (relative_offset.y() >= 0) {
+        shift_assign<Direction::right>(relative_offset.y());
+    } else {
+        shift_assign<Direction::left>(-relative_offset.y());
+    }
+    return *this;
+}
+
+constexpr BitBoard BitBoard::neighbors_cardinal(BitBoard position) noexcept
+{
+    BITBOARD_COUNT(Probe::neighbors);
+    return shift<right>(position) | shift<up>(position) | shift<left>(position) | shift<down>(position);
+}
+
+constexpr BitBoard BitBoard::neighbors_cardinal(const Position& position) noexcept
+{
+    return neighbors_cardinal(BitBoard{position});
+}
+
+constexpr BitBoard BitBoard::neighbors_diagonal(BitBoard position) noexcept
+{
+    BITBOARD_COUNT(Probe::neighbors);
+    return shift<upright>(position) | shift<upleft>(position) | shift<downleft>(position) | shift<downright>(position);
+}
+
+constexpr BitBoard BitBoard::neighbors_diagonal(const Position& position) noexcept
+{
+    return neighbors_diagonal(BitBoard{position});
+}
+
+constexpr BitBoard BitBoard::neighbors_cardinal_and_diagonal(const BitBoard position) noexcept
+{
+    BITBOARD_COUNT(Probe::neighbors);
+    return shift<right>(position) | shift<upright>(position) | shift<up>(position) | shift<upleft>(position) |
+           shift<left>(position) | shift<downleft>(position) | shift<down>(position) | shift<downright>(position);
+}
+
+constexpr BitBoard BitBoard::neighbors_cardinal_and_diagonal(const Position& position) noexcept
+{
+    return neighbors_cardinal_and_diagonal(BitBoard{position});
+}
+
+constexpr BitBoard BitBoard::flip_vertical(const BitBoard board) noexcept
+{
+    constexpr Bits k1 = 0x00FF00FF00FF00FF;
+    constexpr Bits k2 = 0x0000FFFF0000FFFF;
+    Bits bits = board.bits_;
+    bits = ((bits >> 8) & k1) | ((bits & k1) << 8);
+    bits = ((bits >> 16) & k2) | ((bits & k2) << 16);
+    bits = (bits >> 32) | (bits << 32);
+    return BitBoard{bits};
+}
+
+constexpr BitBoard BitBoard::flip_horizontal(const BitBoard board) noexcept
+{
+    constexpr Bits k1 = 0x5555555555555555;
+    constexpr Bits k2 = 0x3333333333333333;
+    constexpr Bits k4 = 0x0f0f0f0f0f0f0f0f;
+    Bits bits = board.bits_;
+    bits = ((bits >> 1) & k1) | ((bits & k1) << 1);
+    bits = ((bits >> 2) & k2) | ((bits & k2) << 2);
+    bits = ((bits >> 4) & k4) | ((bits & k4) << 4);
+    return BitBoard{bits};
+}
+
+constexpr BitBoard BitBoard::flip_diagonal(const BitBoard board) noexcept
+{
+    constexpr Bits k1 = 0x5500550055005500;
+    constexpr Bits k2 = 0x3333000033330000;
+    constexpr Bits k4 = 0x0f0f0f0f00000000;
+    Bits bits = board.bits_;
+    Bits t = k4 & (bits ^ (bits << 28));
+    bits ^= t ^ (t >> 28);
+    t = k2 & (bits ^ (bits << 14));
+    bits ^= t ^ (t >> 14);
+    t = k1 & (bits ^ (bits << 7));
+    bits ^= t ^ (t >> 7);
+    return BitBoard{bits};
+}
+
+constexpr BitBoard BitBoard::flip_anti_diagonal(const BitBoard board) noexcept
+{
+    constexpr Bits k1 = 0xaa00aa00aa00aa00;
+    constexpr Bits k2 = 0xcccc0000cccc0000;
+    constexpr Bits k4 = 0xf0f0f0f00f0f0f0f;
+    Bits bits = board.bits_;
+    Bits t = bits ^ (bits << 36);
+    bits ^= k4 & (t ^ (bits >> 36));
+    t = k2 & (bits ^ (bits << 18));
+    bits ^= t ^ (t >> 18);
+    t = k1 & (bits ^ (bits << 9));
+    bits ^= t ^ (t >> 9);
+    return BitBoard{bits};
+}
+
+constexpr BitBoard BitBoard::rotate_clockwise(const BitBoard board) noexcept
+{
+    return flip_diagonal(flip_vertical(board));
+}
+
+constexpr BitBoard BitBoard::rotate_half_turn(const BitBoard board) noexcept
+{
+    return flip_vertical(flip_horizontal(board));
+}
+
+constexpr BitBoard BitBoard::rotate_counterclockwise(const BitBoard board) noexcept
+{
+    return flip_vertical(flip_diagonal(board));
+}
+
+constexpr BitBoard BitBoard::canonical(const BitBoard board) noexcept
+{
+    auto smallest = board;
+    for (const auto candidate :
+         {flip_vertical(board), flip_horizontal(board), rotate_half_turn(board), flip_diagonal(board),
+          flip_anti_diagonal(board), rotate_clockwise(board), rotate_counterclockwise(board)}) {
+        if (candidate < smallest) {
+            smallest = candidate;
+        }
+    }
+    return smallest;
+}
+
+consteval BitBoard operator""_bb(const char* board, const std::size_t length)
+{
+    return BitBoard{std::string_view{board, length}};
+}
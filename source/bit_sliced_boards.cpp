@@ -0,0 +1,46 @@
+#include "bit_sliced_boards.h"
+
+#include "bit_board.h"
+#include "kernels.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <stdexcept>
+
+static_assert(sizeof(BitBoard) == sizeof(BitBoard::Bits), "boards are transposed as raw words");
+
+void transpose_boards(std::span<const BitBoard> boards, std::span<BitBoard::Bits, BitBoard::n_bits> planes)
+{
+    if (boards.size() > BitSlicedBoards::n_boards) {
+        throw std::invalid_argument("at most 64 boards can be sliced together");
+    }
+    std::array<BitBoard::Bits, BitSlicedBoards::n_boards> rows{};
+    std::transform(boards.begin(), boards.end(), rows.begin(), [](const BitBoard board) { return board.to_ullong(); });
+    kernels().transpose_64x64(rows, planes);
+}
+
+void transpose_planes(
+    std::span<const BitBoard::Bits, BitBoard::n_bits> planes, std::span<BitBoard, BitSlicedBoards::n_boards> boards
+) noexcept
+{
+    std::array<BitBoard::Bits, BitSlicedBoards::n_boards> rows;
+    kernels().transpose_64x64(planes, rows);
+    std::transform(rows.begin(), rows.end(), boards.begin(), [](const BitBoard::Bits bits) { return BitBoard{bits}; });
+}
+
+BitSlicedBoards::BitSlicedBoards(std::span<const BitBoard> boards) : BitSlicedBoards()
+{
+    transpose_boards(boards, planes_);
+}
+
+void BitSlicedBoards::to_boards(std::span<BitBoard, n_boards> boards) const noexcept
+{
+    transpose_planes(planes_, boards);
+}
+
+BitSlicedBoards::Bits BitSlicedBoards::square(const Position& position) const
+{
+    return planes_[static_cast<std::size_t>(std::countl_zero(BitBoard{position}.to_ullong()))];
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+
+#include <array>
+#include <bit>
+#include <span>
+
+// 64 boards stored square-major: plane(i) holds square i of every board, with board b at bit (63 - b), mirroring
+// the square order of a BitBoard. A boolean function applied plane by plane evaluates all 64 boards at once.
+class BitSlicedBoards
+{
+  public:
+    using Bits = BitBoard::Bits;
+    using Position = BitBoard::Position;
+    using Planes = std::array<Bits, BitBoard::n_bits>;
+
+    static constexpr std::size_t n_boards = 64;
+    static constexpr std::size_t n_count_planes = 7;
+    using CountPlanes = std::array<Bits, n_count_planes>;
+
+    constexpr explicit BitSlicedBoards() noexcept : planes_{} {}
+    explicit BitSlicedBoards(std::span<const BitBoard> boards);
+
+    [[nodiscard]] static constexpr BitSlicedBoards from_planes(const Planes& planes) noexcept
+    {
+        BitSlicedBoards sliced;
+        sliced.planes_ = planes;
+        return sliced;
+    }
+
+    void to_boards(std::span<BitBoard, n_boards> boards) const noexcept;
+
+    [[nodiscard]] static constexpr Bits lane(const std::size_t board) noexcept
+    {
+        return Bits{1} << (n_boards - 1 - board);
+    }
+
+    [[nodiscard]] constexpr const Planes& planes() const noexcept
+    {
+        return planes_;
+    }
+
+    // Boards with the given square set.
+    [[nodiscard]] constexpr Bits square(const std::size_t index) const noexcept
+    {
+        return planes_[index];
+    }
+    [[nodiscard]] Bits square(const Position& position) const;
+
+    // Boards sharing at least one square with mask, and boards containing every square of mask.
+    [[nodiscard]] constexpr Bits any_of(const BitBoard mask) const noexcept
+    {
+        Bits lanes = 0;
+        for_each_index(mask, [&](const std::size_t index) { lanes |= planes_[index]; });
+        return lanes;
+    }
+    [[nodiscard]] constexpr Bits all_of(const BitBoard mask) const noexcept
+    {
+        Bits lanes = ~Bits{0};
+        for_each_index(mask, [&](const std::size_t index) { lanes &= planes_[index]; });
+        return lanes;
+    }
+
+    // Per-board popcount as 7 bit planes, least significant first.
+    [[nodiscard]] constexpr CountPlanes count_planes() const noexcept
+    {
+        CountPlanes counts{};
+        for (auto carry : planes_) {
+            for (std::size_t bit = 0; carry != 0 && bit < n_count_planes; ++bit) {
+                const auto sum = counts[bit] ^ carry;
+                carry &= counts[bit];
+                counts[bit] = sum;
+            }
+        }
+        return counts;
+    }
+
+    [[nodiscard]] static constexpr Bits greater(const CountPlanes& lhs, const CountPlanes& rhs) noexcept
+    {
+        Bits greater = 0;
+        Bits equal = ~Bits{0};
+        for (std::size_t bit = n_count_planes; bit-- > 0;) {
+            greater |= equal & lhs[bit] & ~rhs[bit];
+            equal &= ~(lhs[bit] ^ rhs[bit]);
+        }
+        return greater;
+    }
+
+    [[nodiscard]] static constexpr CountPlanes broadcast_count(const std::size_t count) noexcept
+    {
+        CountPlanes planes{};
+        for (std::size_t bit = 0; bit < n_count_planes; ++bit) {
+            planes[bit] = ((count >> bit) & 1) != 0 ? ~Bits{0} : 0;
+        }
+        return planes;
+    }
+
+    // Boards with more set squares than the corresponding board of other.
+    [[nodiscard]] constexpr Bits count_greater(const BitSlicedBoards& other) const noexcept
+    {
+        return greater(count_planes(), other.count_planes());
+    }
+
+    [[nodiscard]] constexpr Bits count_at_least(const std::size_t k) const noexcept
+    {
+        return k == 0 ? ~Bits{0} : greater(count_planes(), broadcast_count(k - 1));
+    }
+
+    constexpr BitSlicedBoards& operator&=(const BitSlicedBoards& other) noexcept
+    {
+        for (std::size_t i = 0; i < planes_.size(); ++i) {
+            planes_[i] &= other.planes_[i];
+        }
+        return *this;
+    }
+    [[nodiscard]] constexpr BitSlicedBoards operator&(const BitSlicedBoards& other) const noexcept
+    {
+        return BitSlicedBoards{*this} &= other;
+    }
+    constexpr BitSlicedBoards& operator|=(const BitSlicedBoards& other) noexcept
+    {
+        for (std::size_t i = 0; i < planes_.size(); ++i) {
+            planes_[i] |= other.planes_[i];
+        }
+        return *this;
+    }
+    [[nodiscard]] constexpr BitSlicedBoards operator|(const BitSlicedBoards& other) const noexcept
+    {
+        return BitSlicedBoards{*this} |= other;
+    }
+    constexpr BitSlicedBoards& operator^=(const BitSlicedBoards& other) noexcept
+    {
+        for (std::size_t i = 0; i < planes_.size(); ++i) {
+            planes_[i] ^= other.planes_[i];
+        }
+        return *this;
+    }
+    [[nodiscard]] constexpr BitSlicedBoards operator^(const BitSlicedBoards& other) const noexcept
+    {
+        return BitSlicedBoards{*this} ^= other;
+    }
+    [[nodiscard]] constexpr BitSlicedBoards operator~() const noexcept
+    {
+        BitSlicedBoards result;
+        for (std::size_t i = 0; i < planes_.size(); ++i) {
+            result.planes_[i] = ~planes_[i];
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr friend bool operator==(const BitSlicedBoards& lhs, const BitSlicedBoards& rhs) noexcept
+    {
+        return lhs.planes_ == rhs.planes_;
+    }
+
+  private:
+    Planes planes_;
+
+    template <typename F>
+    static constexpr void for_each_index(const BitBoard mask, F&& f)
+    {
+        for (Bits bits = mask.to_ullong(); bits != 0;) {
+            const auto index = static_cast<std::size_t>(std::countl_zero(bits));
+            bits &= ~lane(index);
+            f(index);
+        }
+    }
+};
+
+// Transposes up to 64 boards into square planes and back; missing boards are treated as empty.
+void transpose_boards(std::span<const BitBoard> boards, std::span<BitBoard::Bits, BitBoard::n_bits> planes);
+
+void transpose_planes(
+    std::span<const BitBoard::Bits, BitBoard::n_bits> planes, std::span<BitBoard, BitSlicedBoards::n_boards> boards
+) noexcept;
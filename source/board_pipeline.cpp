@@ -0,0 +1,365 @@
+#include "board_pipeline.h"
+
+#include "bit_board.h"
+#include "bounded_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using BatchQueue = BoundedQueue<BoardBatch*>;
+
+std::uint64_t nanoseconds_since(const Clock::time_point start) noexcept
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+struct StageCounters
+{
+    alignas(64) std::atomic<std::uint64_t> batches{0};
+    std::atomic<std::uint64_t> boards{0};
+    std::atomic<std::uint64_t> busy_ns{0};
+    std::atomic<std::uint64_t> starved_ns{0};
+    std::atomic<std::uint64_t> blocked_ns{0};
+    std::atomic<std::uint64_t> queue_depth_total{0};
+    std::atomic<std::uint64_t> queue_depth_max{0};
+
+    void record_batch(const std::size_t n_boards, const std::size_t queue_depth, const std::uint64_t busy) noexcept
+    {
+        batches.fetch_add(1, std::memory_order_relaxed);
+        boards.fetch_add(n_boards, std::memory_order_relaxed);
+        busy_ns.fetch_add(busy, std::memory_order_relaxed);
+        queue_depth_total.fetch_add(queue_depth, std::memory_order_relaxed);
+        auto max = queue_depth_max.load(std::memory_order_relaxed);
+        while (queue_depth > max && !queue_depth_max.compare_exchange_weak(max, queue_depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    [[nodiscard]] StageStats to_stats(std::string name) const
+    {
+        constexpr double seconds_per_ns = 1e-9;
+        StageStats stats;
+        stats.name = std::move(name);
+        stats.batches = batches.load();
+        stats.boards = boards.load();
+        stats.busy_seconds = static_cast<double>(busy_ns.load()) * seconds_per_ns;
+        stats.starved_seconds = static_cast<double>(starved_ns.load()) * seconds_per_ns;
+        stats.blocked_seconds = static_cast<double>(blocked_ns.load()) * seconds_per_ns;
+        stats.queue_depth_total = queue_depth_total.load();
+        stats.queue_depth_max = queue_depth_max.load();
+        return stats;
+    }
+};
+
+class Pipeline
+{
+  public:
+    Pipeline(
+        const BoardReader& reader,
+        std::span<const PipelineStage> transforms,
+        const BatchWriter& writer,
+        const PipelineOptions& options
+    )
+        : reader_(reader),
+          transforms_(transforms),
+          writer_(writer),
+          options_(options),
+          n_workers_(worker_count(options, transforms.size())),
+          n_batches_(options.queue_capacity * (transforms.size() + 1) + n_workers_ + 2),
+          batches_(n_batches_),
+          free_(n_batches_),
+          counters_(transforms.size() + 2)
+    {
+        for (auto& batch : batches_) {
+            batch.boards.resize(options.batch_size, BitBoard{});
+            batch.features.resize(options.batch_size, BoardFeatures{BitBoard{}, BitBoard{}, 0, false});
+            auto* p = &batch;
+            static_cast<void>(free_.try_push(p));
+        }
+        // Pool workers share every transform, so a worker blocked on a full output queue could starve the stage
+        // that would drain it. Their output queues hold every batch instead; the batch pool bounds the pipeline.
+        const bool pooled = options.execution == PipelineExecution::pooled;
+        queues_.reserve(transforms.size() + 1);
+        queues_.push_back(std::make_unique<BatchQueue>(options.queue_capacity, 1));
+        for (std::size_t stage = 0; stage < transforms.size(); ++stage) {
+            queues_.push_back(std::make_unique<BatchQueue>(
+                pooled ? n_batches_ : options.queue_capacity, pooled ? n_workers_ : 1U
+            ));
+        }
+    }
+
+    PipelineStats run()
+    {
+        const auto start = Clock::now();
+        std::vector<std::thread> threads;
+        threads.emplace_back([this] { guarded([this] { read(); }); });
+        if (options_.execution == PipelineExecution::pooled) {
+            for (unsigned worker = 0; worker < n_workers_; ++worker) {
+                threads.emplace_back([this] { guarded([this] { transform(0, transforms_.size()); }); });
+            }
+        } else {
+            for (std::size_t stage = 0; stage < transforms_.size(); ++stage) {
+                threads.emplace_back([this, stage] { guarded([this, stage] { transform(stage, stage + 1); }); });
+            }
+        }
+        guarded([this] { write(); });
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+
+        PipelineStats stats;
+        stats.wall_seconds = static_cast<double>(nanoseconds_since(start)) * 1e-9;
+        stats.stages.push_back(counters_.front().to_stats("read"));
+        for (std::size_t stage = 0; stage < transforms_.size(); ++stage) {
+            stats.stages.push_back(counters_[stage + 1].to_stats(transforms_[stage].name));
+        }
+        stats.stages.push_back(counters_.back().to_stats("write"));
+        stats.boards = stats.stages.back().boards;
+        return stats;
+    }
+
+  private:
+    const BoardReader& reader_;
+    std::span<const PipelineStage> transforms_;
+    const BatchWriter& writer_;
+    PipelineOptions options_;
+    unsigned n_workers_;
+    std::size_t n_batches_;
+    std::vector<BoardBatch> batches_;
+    BatchQueue free_;
+    std::vector<std::unique_ptr<BatchQueue>> queues_;
+    std::vector<StageCounters> counters_;
+    std::atomic<bool> failed_{false};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+
+    static unsigned worker_count(const PipelineOptions& options, const std::size_t n_transforms) noexcept
+    {
+        if (options.execution == PipelineExecution::thread_per_stage) {
+            return static_cast<unsigned>(n_transforms);
+        }
+        if (options.pool_threads != 0) {
+            return options.pool_threads;
+        }
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    template <typename F>
+    void guarded(F&& f) noexcept
+    {
+        try {
+            f();
+        } catch (...) {
+            const std::lock_guard lock{error_mutex_};
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    // Waits for a batch; returns false once the queue is closed and drained, or the run has failed.
+    bool pop_wait(BatchQueue& queue, BoardBatch*& batch, std::atomic<std::uint64_t>& starved_ns) noexcept
+    {
+        if (queue.try_pop(batch)) {
+            return true;
+        }
+        const auto start = Clock::now();
+        bool popped = false;
+        while (!failed_.load(std::memory_order_relaxed)) {
+            if (queue.try_pop(batch)) {
+                popped = true;
+                break;
+            }
+            if (queue.closed()) {
+                popped = queue.try_pop(batch);
+                break;
+            }
+            std::this_thread::yield();
+        }
+        starved_ns.fetch_add(nanoseconds_since(start), std::memory_order_relaxed);
+        return popped;
+    }
+
+    void push_wait(BatchQueue& queue, BoardBatch* batch, std::atomic<std::uint64_t>& blocked_ns) noexcept
+    {
+        if (queue.try_push(batch)) {
+            return;
+        }
+        const auto start = Clock::now();
+        while (!queue.try_push(batch) && !failed_.load(std::memory_order_relaxed)) {
+            std::this_thread::yield();
+        }
+        blocked_ns.fetch_add(nanoseconds_since(start), std::memory_order_relaxed);
+    }
+
+    void read()
+    {
+        auto& counters = counters_.front();
+        auto& output = *queues_.front();
+        for (std::size_t sequence = 0;; ++sequence) {
+            BoardBatch* batch = nullptr;
+            // Waiting for a recycled batch means every batch is queued downstream: that is the backpressure.
+            if (!pop_wait(free_, batch, counters.blocked_ns)) {
+                break;
+            }
+            const auto start = Clock::now();
+            const auto n = reader_(std::span{batch->boards});
+            const auto busy = nanoseconds_since(start);
+            if (n == 0) {
+                counters.busy_ns.fetch_add(busy, std::memory_order_relaxed);
+                static_cast<void>(free_.try_push(batch));
+                break;
+            }
+            counters.record_batch(n, 0, busy);
+            batch->sequence = sequence;
+            batch->size = n;
+            push_wait(output, batch, counters.blocked_ns);
+            if (n < options_.batch_size) {
+                break;
+            }
+        }
+        output.close_producer();
+    }
+
+    void transform(const std::size_t first_stage, const std::size_t last_stage)
+    {
+        std::vector<bool> done(last_stage - first_stage, false);
+        std::size_t remaining = done.size();
+        while (remaining > 0 && !failed_.load(std::memory_order_relaxed)) {
+            bool progressed = false;
+            // Downstream stages first, so batches already in flight drain before new ones are started.
+            for (auto stage = last_stage; stage-- > first_stage;) {
+                if (done[stage - first_stage]) {
+                    continue;
+                }
+                auto& input = *queues_[stage];
+                const auto depth = input.size();
+                BoardBatch* batch = nullptr;
+                if (input.try_pop(batch) || (input.closed() && input.try_pop(batch))) {
+                    auto& counters = counters_[stage + 1];
+                    const auto start = Clock::now();
+                    transforms_[stage].transform(*batch);
+                    counters.record_batch(batch->size, depth, nanoseconds_since(start));
+                    push_wait(*queues_[stage + 1], batch, counters.blocked_ns);
+                    progressed = true;
+                    break;
+                }
+                if (input.closed()) {
+                    done[stage - first_stage] = true;
+                    --remaining;
+                    queues_[stage + 1]->close_producer();
+                }
+            }
+            if (!progressed && remaining > 0) {
+                const auto first_open = std::find(done.begin(), done.end(), false) - done.begin();
+                const auto start = Clock::now();
+                std::this_thread::yield();
+                counters_[first_stage + static_cast<std::size_t>(first_open) + 1].starved_ns.fetch_add(
+                    nanoseconds_since(start), std::memory_order_relaxed
+                );
+            }
+        }
+    }
+
+    void write()
+    {
+        auto& counters = counters_.back();
+        auto& input = *queues_.back();
+        std::vector<BoardBatch*> pending(n_batches_, nullptr);
+        std::size_t next = 0;
+        for (;;) {
+            const auto depth = input.size();
+            BoardBatch* batch = nullptr;
+            if (!pop_wait(input, batch, counters.starved_ns)) {
+                break;
+            }
+            // Pooled transforms can finish out of order; at most n_batches_ sequences are ever in flight.
+            pending[batch->sequence % n_batches_] = batch;
+            while (pending[next % n_batches_] != nullptr) {
+                BoardBatch* const ready = std::exchange(pending[next % n_batches_], nullptr);
+                const auto start = Clock::now();
+                writer_(*ready);
+                counters.record_batch(ready->size, depth, nanoseconds_since(start));
+                push_wait(free_, ready, counters.blocked_ns);
+                ++next;
+            }
+        }
+    }
+};
+
+} // namespace
+
+PipelineStats run_pipeline(
+    const BoardReader& reader,
+    std::span<const PipelineStage> transforms,
+    const BatchWriter& writer,
+    const PipelineOptions& options
+)
+{
+    Pipeline pipeline{reader, transforms, writer, options};
+    return pipeline.run();
+}
+
+BoardReader make_stream_reader(std::istream& in)
+{
+    static_assert(sizeof(BitBoard) == sizeof(BitBoard::Bits), "boards are read as raw words");
+    return [&in](std::span<BitBoard> boards) -> std::size_t {
+        in.read(reinterpret_cast<char*>(boards.data()), static_cast<std::streamsize>(boards.size_bytes()));
+        return static_cast<std::size_t>(in.gcount()) / sizeof(BitBoard);
+    };
+}
+
+void canonicalize_batch(BoardBatch& batch) noexcept
+{
+    for (auto& board : batch.active_boards()) {
+        board = BitBoard::canonical(board);
+    }
+}
+
+void compute_features(BoardBatch& batch) noexcept
+{
+    const auto boards = batch.active_boards();
+    const auto features = batch.active_features();
+    for (std::size_t i = 0; i < boards.size(); ++i) {
+        const auto board = boards[i];
+        features[i] = BoardFeatures{
+            board,
+            BitBoard::neighbors_cardinal_and_diagonal(board) & ~board,
+            static_cast<std::uint8_t>(board.count()),
+            board.on_any_edge(),
+        };
+    }
+}
+
+void export_pipeline_stats(std::ostream& out, const PipelineStats& stats)
+{
+    out << "stage,batches,boards,busy_seconds,starved_seconds,blocked_seconds,boards_per_second,mean_queue_depth,"
+           "max_queue_depth\n";
+    for (const auto& stage : stats.stages) {
+        out << stage.name << ',' << stage.batches << ',' << stage.boards << ',' << stage.busy_seconds << ','
+            << stage.starved_seconds << ',' << stage.blocked_seconds << ',' << stage.boards_per_second() << ','
+            << stage.mean_queue_depth() << ',' << stage.queue_depth_max << '\n';
+    }
+    out << "total,," << stats.boards << ',' << stats.wall_seconds << ",,,"
+        << (stats.wall_seconds > 0 ? static_cast<double>(stats.boards) / stats.wall_seconds : 0) << ",,\n";
+}
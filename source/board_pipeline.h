@@ -0,0 +1,118 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+struct BoardFeatures
+{
+    BitBoard board;
+    BitBoard neighbors;
+    std::uint8_t count;
+    bool on_any_edge;
+};
+
+// Batches are allocated once per run and recycled; stages receive them by pointer, so boards are never copied
+// between stages. Only the first `size` entries of `boards` and `features` are meaningful.
+struct BoardBatch
+{
+    std::size_t sequence{0};
+    std::size_t size{0};
+    std::vector<BitBoard> boards;
+    std::vector<BoardFeatures> features;
+
+    [[nodiscard]] std::span<BitBoard> active_boards() noexcept
+    {
+        return std::span{boards}.first(size);
+    }
+    [[nodiscard]] std::span<const BitBoard> active_boards() const noexcept
+    {
+        return std::span{boards}.first(size);
+    }
+    [[nodiscard]] std::span<BoardFeatures> active_features() noexcept
+    {
+        return std::span{features}.first(size);
+    }
+    [[nodiscard]] std::span<const BoardFeatures> active_features() const noexcept
+    {
+        return std::span{features}.first(size);
+    }
+};
+
+// Fills the span from the front and returns how many boards were read; a short read ends the stream.
+using BoardReader = std::function<std::size_t(std::span<BitBoard> boards)>;
+using BatchTransform = std::function<void(BoardBatch& batch)>;
+using BatchWriter = std::function<void(const BoardBatch& batch)>;
+
+struct PipelineStage
+{
+    std::string name;
+    BatchTransform transform;
+};
+
+enum class PipelineExecution
+{
+    thread_per_stage,
+    pooled,
+};
+
+struct PipelineOptions
+{
+    std::size_t batch_size{4096};
+    std::size_t queue_capacity{8};
+    PipelineExecution execution{PipelineExecution::thread_per_stage};
+    unsigned pool_threads{0};
+};
+
+struct StageStats
+{
+    std::string name;
+    std::uint64_t batches{0};
+    std::uint64_t boards{0};
+    double busy_seconds{0};
+    double starved_seconds{0};
+    double blocked_seconds{0};
+    std::uint64_t queue_depth_total{0};
+    std::uint64_t queue_depth_max{0};
+
+    [[nodiscard]] double boards_per_second() const noexcept
+    {
+        return busy_seconds > 0 ? static_cast<double>(boards) / busy_seconds : 0;
+    }
+    [[nodiscard]] double mean_queue_depth() const noexcept
+    {
+        return batches > 0 ? static_cast<double>(queue_depth_total) / static_cast<double>(batches) : 0;
+    }
+};
+
+struct PipelineStats
+{
+    std::vector<StageStats> stages;
+    double wall_seconds{0};
+    std::uint64_t boards{0};
+};
+
+// Runs reader -> transforms... -> writer until the reader is exhausted. The reader and writer each own a thread;
+// transforms get one thread each (thread_per_stage) or share a pool. Batches reach the writer in read order.
+PipelineStats run_pipeline(
+    const BoardReader& reader,
+    std::span<const PipelineStage> transforms,
+    const BatchWriter& writer,
+    const PipelineOptions& options = {}
+);
+
+[[nodiscard]] BoardReader make_stream_reader(std::istream& in);
+
+void canonicalize_batch(BoardBatch& batch) noexcept;
+
+void compute_features(BoardBatch& batch) noexcept;
+
+void export_pipeline_stats(std::ostream& out, const PipelineStats& stats);
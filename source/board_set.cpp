@@ -0,0 +1,858 @@
+#include "board_set.h"
+
+#include "board_sort.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <iterator>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using Bits = BitBoard::Bits;
+using Bitmap = std::array<std::uint64_t, BoardSetView::bitmap_words>;
+using ContainerType = BoardSetView::ContainerType;
+
+template <typename T>
+T load(const std::byte* source) noexcept
+{
+    T value{};
+    std::memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+template <typename T>
+void store(std::byte* destination, const T value) noexcept
+{
+    std::memcpy(destination, &value, sizeof(value));
+}
+
+std::uint16_t low_bits(const Bits bits) noexcept
+{
+    return static_cast<std::uint16_t>(bits);
+}
+
+Bits chunk_key_of(const Bits bits) noexcept
+{
+    return bits >> BoardSetView::chunk_bits;
+}
+
+std::uint64_t bitmap_word(const std::byte* data, const std::size_t word) noexcept
+{
+    return load<std::uint64_t>(data + word * sizeof(std::uint64_t));
+}
+
+std::uint16_t array_value(const std::byte* data, const std::size_t index) noexcept
+{
+    return load<std::uint16_t>(data + index * sizeof(std::uint16_t));
+}
+
+std::array<std::uint16_t, 2> run_at(const std::byte* data, const std::size_t run) noexcept
+{
+    return load<std::array<std::uint16_t, 2>>(data + run * 2 * sizeof(std::uint16_t));
+}
+
+std::uint16_t select_in_word(std::uint64_t word, std::size_t index) noexcept
+{
+    for (; index > 0; --index) {
+        word &= word - 1;
+    }
+    return static_cast<std::uint16_t>(std::countr_zero(word));
+}
+
+// Data offset in bits 24-63, container count (up to chunk_values) in bits 2-23 and type in bits 0-1.
+std::uint64_t pack_container(const std::uint64_t offset, const std::uint64_t count, const ContainerType type) noexcept
+{
+    return (offset << 24) | (count << 2) | static_cast<std::uint64_t>(type);
+}
+
+std::uint64_t packed_offset(const std::uint64_t packed) noexcept
+{
+    return packed >> 24;
+}
+
+std::size_t packed_count(const std::uint64_t packed) noexcept
+{
+    return static_cast<std::size_t>((packed >> 2) & 0x3fffff);
+}
+
+std::uint64_t packed_type(const std::uint64_t packed) noexcept
+{
+    return packed & 0x3;
+}
+
+std::size_t count_runs(const Bitmap& bitmap) noexcept
+{
+    std::size_t runs = 0;
+    std::uint64_t carry = 0;
+    for (const auto word : bitmap) {
+        const auto starts = word & ~((word << 1) | carry);
+        runs += std::popcount(starts);
+        carry = word >> 63;
+    }
+    return runs;
+}
+
+} // namespace
+
+class BoardSetBuilder
+{
+  public:
+    void add_chunk(const Bits key, std::span<const std::uint16_t> values)
+    {
+        assert(!values.empty());
+        assert(std::is_sorted(values.begin(), values.end()));
+
+        std::size_t runs = 1;
+        for (std::size_t i = 1; i < values.size(); ++i) {
+            runs += (values[i] != values[i - 1] + 1) ? 1 : 0;
+        }
+        const auto type = choose_type(values.size(), runs);
+        const auto count = type == ContainerType::run ? runs : values.size();
+        if (values.size() * BoardSetView::loose_board_bytes <=
+            BoardSetView::chunk_entry_bytes + container_bytes(type, count)) {
+            for (const auto value : values) {
+                add_loose(BitBoard{(key << BoardSetView::chunk_bits) | value});
+            }
+            return;
+        }
+        begin_chunk(key, type, values.size(), count);
+
+        switch (type) {
+        case ContainerType::array:
+            for (const auto value : values) {
+                append(value);
+            }
+            break;
+        case ContainerType::bitmap: {
+            Bitmap bitmap{};
+            for (const auto value : values) {
+                bitmap[value / 64] |= std::uint64_t{1} << (value % 64);
+            }
+            append_bitmap(bitmap);
+            break;
+        }
+        case ContainerType::run: {
+            std::size_t start = 0;
+            for (std::size_t i = 1; i <= values.size(); ++i) {
+                if (i == values.size() || values[i] != values[i - 1] + 1) {
+                    append(values[start]);
+                    append(static_cast<std::uint16_t>(i - start - 1));
+                    start = i;
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    void add_chunk(const Bits key, const Bitmap& bitmap)
+    {
+        std::size_t cardinality = 0;
+        for (const auto word : bitmap) {
+            cardinality += std::popcount(word);
+        }
+        if (cardinality == 0) {
+            return;
+        }
+        const auto runs = count_runs(bitmap);
+        const auto type = choose_type(cardinality, runs);
+        if (type == ContainerType::bitmap) {
+            begin_chunk(key, type, cardinality, cardinality);
+            append_bitmap(bitmap);
+            return;
+        }
+        std::vector<std::uint16_t> values;
+        values.reserve(cardinality);
+        for (std::size_t word = 0; word < bitmap.size(); ++word) {
+            for (auto bits = bitmap[word]; bits != 0; bits &= bits - 1) {
+                values.push_back(static_cast<std::uint16_t>(word * 64 + std::countr_zero(bits)));
+            }
+        }
+        add_chunk(key, values);
+    }
+
+    // Containers come from chunks that were worth building, so they stay chunks.
+    void add_container(const Bits key, const BoardSetView::Container& container)
+    {
+        begin_chunk(key, container.type, container.cardinality, container.count);
+        const auto n_bytes = container_bytes(container.type, container.count);
+        data_.insert(data_.end(), container.data, container.data + n_bytes);
+    }
+
+    void add_loose(const BitBoard board)
+    {
+        assert(loose_.empty() || loose_.back() < board);
+        loose_.push_back(board);
+    }
+
+    [[nodiscard]] BoardSet finish()
+    {
+        const auto chunk_table_bytes = chunks_.size() * BoardSetView::chunk_entry_bytes;
+        const auto loose_bytes = loose_.size() * BoardSetView::loose_board_bytes;
+        std::vector<std::byte> storage(BoardSetView::header_bytes + chunk_table_bytes + loose_bytes + data_.size());
+        auto* out = storage.data();
+        store<std::uint64_t>(out, BoardSetView::format_magic);
+        store<std::uint64_t>(out + 8, chunks_.size());
+        store<std::uint64_t>(out + 16, loose_.size());
+        store<std::uint64_t>(out + 24, chunked_size_ + loose_.size());
+        store<std::uint64_t>(out + 32, data_.size());
+        out += BoardSetView::header_bytes;
+        for (const auto& chunk : chunks_) {
+            store<std::uint64_t>(out, chunk.key);
+            store<std::uint64_t>(out + 8, chunk.rank);
+            store<std::uint64_t>(out + 16, pack_container(chunk.offset, chunk.count, chunk.type));
+            out += BoardSetView::chunk_entry_bytes;
+        }
+        for (const auto board : loose_) {
+            store<std::uint64_t>(out, board.to_ullong());
+            out += BoardSetView::loose_board_bytes;
+        }
+        std::copy(data_.begin(), data_.end(), out);
+        return BoardSet{std::move(storage)};
+    }
+
+    static std::size_t container_bytes(const ContainerType type, const std::size_t count) noexcept
+    {
+        switch (type) {
+        case ContainerType::array:
+            return count * sizeof(std::uint16_t);
+        case ContainerType::bitmap:
+            return sizeof(Bitmap);
+        case ContainerType::run:
+            return count * 2 * sizeof(std::uint16_t);
+        }
+        return 0;
+    }
+
+  private:
+    struct Chunk
+    {
+        Bits key;
+        std::uint64_t rank;
+        std::uint64_t offset;
+        ContainerType type;
+        std::uint64_t count;
+    };
+
+    std::vector<Chunk> chunks_;
+    std::vector<BitBoard> loose_;
+    std::vector<std::byte> data_;
+    std::uint64_t chunked_size_{0};
+
+    static ContainerType choose_type(const std::size_t cardinality, const std::size_t runs) noexcept
+    {
+        const auto run_bytes = container_bytes(ContainerType::run, runs);
+        const auto array_bytes = container_bytes(ContainerType::array, cardinality);
+        const auto bitmap_bytes = sizeof(Bitmap);
+        if (run_bytes < std::min(array_bytes, bitmap_bytes)) {
+            return ContainerType::run;
+        }
+        if (cardinality <= BoardSetView::max_array_values) {
+            return ContainerType::array;
+        }
+        return ContainerType::bitmap;
+    }
+
+    void begin_chunk(const Bits key, const ContainerType type, const std::size_t cardinality, const std::size_t count)
+    {
+        assert(chunks_.empty() || chunks_.back().key < key);
+        align_data(type);
+        chunks_.push_back({key, chunked_size_, data_.size(), type, count});
+        chunked_size_ += cardinality;
+    }
+
+    void align_data(const ContainerType type)
+    {
+        if (type == ContainerType::bitmap) {
+            data_.resize((data_.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t) * sizeof(std::uint64_t));
+        }
+    }
+
+    void append(const std::uint16_t value)
+    {
+        const auto offset = data_.size();
+        data_.resize(offset + sizeof(value));
+        store(data_.data() + offset, value);
+    }
+
+    void append_bitmap(const Bitmap& bitmap)
+    {
+        const auto offset = data_.size();
+        data_.resize(offset + sizeof(bitmap));
+        std::memcpy(data_.data() + offset, bitmap.data(), sizeof(bitmap));
+    }
+};
+
+BoardSetView::BoardSetView(std::span<const std::byte> bytes) noexcept : bytes_(bytes)
+{
+    if (bytes.size() < header_bytes) {
+        return;
+    }
+    chunk_count_ = load<std::uint64_t>(bytes.data() + 8);
+    loose_count_ = load<std::uint64_t>(bytes.data() + 16);
+    size_ = load<std::uint64_t>(bytes.data() + 24);
+    chunks_ = bytes.data() + header_bytes;
+    loose_ = chunks_ + chunk_count_ * chunk_entry_bytes;
+    data_ = loose_ + loose_count_ * loose_board_bytes;
+}
+
+BoardSetView BoardSetView::from_bytes(std::span<const std::byte> bytes)
+{
+    if (bytes.size() < header_bytes || load<std::uint64_t>(bytes.data()) != format_magic) {
+        throw std::invalid_argument("not a board set image");
+    }
+    const auto chunk_count = load<std::uint64_t>(bytes.data() + 8);
+    const auto loose_count = load<std::uint64_t>(bytes.data() + 16);
+    const auto size = load<std::uint64_t>(bytes.data() + 24);
+    const auto data_bytes = load<std::uint64_t>(bytes.data() + 32);
+    const auto rest = bytes.size() - header_bytes;
+    if (chunk_count > rest / chunk_entry_bytes || loose_count > (rest - chunk_count * chunk_entry_bytes) / loose_board_bytes ||
+        rest != chunk_count * chunk_entry_bytes + loose_count * loose_board_bytes + data_bytes) {
+        throw std::invalid_argument("truncated board set image");
+    }
+
+    // Queries trust every entry, so a corrupt image must not get past here.
+    const BoardSetView view{bytes};
+    std::uint64_t rank = 0;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        const auto* entry = view.chunks_ + chunk * chunk_entry_bytes;
+        const auto key = load<std::uint64_t>(entry);
+        const auto packed = load<std::uint64_t>(entry + 16);
+        const auto offset = packed_offset(packed);
+        const auto count = packed_count(packed);
+        if (key >> (BitBoard::n_bits - chunk_bits) != 0 || (chunk > 0 && key <= view.chunk_key(chunk - 1))) {
+            throw std::invalid_argument("board set chunk keys out of order");
+        }
+        if (packed_type(packed) > static_cast<std::uint64_t>(ContainerType::run) || count == 0 ||
+            count > chunk_values) {
+            throw std::invalid_argument("invalid board set container");
+        }
+        const auto type = static_cast<ContainerType>(packed_type(packed));
+        if (offset > data_bytes || BoardSetBuilder::container_bytes(type, count) > data_bytes - offset) {
+            throw std::invalid_argument("board set container outside of image");
+        }
+        if (load<std::uint64_t>(entry + 8) != rank) {
+            throw std::invalid_argument("board set chunk ranks are not cumulative");
+        }
+        const Container container{type, count, 0, view.data_ + offset};
+        const auto cardinality = validated_cardinality(container);
+        if (type == ContainerType::bitmap && cardinality != count) {
+            throw std::invalid_argument("board set bitmap count does not match its bits");
+        }
+        rank += cardinality;
+    }
+    if (rank + loose_count != size) {
+        throw std::invalid_argument("board set size does not match its chunks");
+    }
+
+    std::size_t chunk = 0;
+    for (std::size_t loose = 0; loose < loose_count; ++loose) {
+        const auto board = view.loose_board(loose);
+        if (loose > 0 && board <= view.loose_board(loose - 1)) {
+            throw std::invalid_argument("board set loose boards out of order");
+        }
+        for (; chunk < chunk_count && view.chunk_key(chunk) < chunk_key_of(board); ++chunk) {
+        }
+        if (chunk < chunk_count && view.chunk_key(chunk) == chunk_key_of(board)) {
+            throw std::invalid_argument("board set loose board inside a chunk");
+        }
+    }
+    return view;
+}
+
+// Cardinality of a container read from an image, checking that its values are strictly increasing.
+std::size_t BoardSetView::validated_cardinality(const Container& container)
+{
+    switch (container.type) {
+    case ContainerType::array:
+        for (std::size_t i = 1; i < container.count; ++i) {
+            if (array_value(container.data, i) <= array_value(container.data, i - 1)) {
+                throw std::invalid_argument("board set array container out of order");
+            }
+        }
+        return container.count;
+    case ContainerType::bitmap: {
+        std::size_t cardinality = 0;
+        for (std::size_t word = 0; word < bitmap_words; ++word) {
+            cardinality += std::popcount(bitmap_word(container.data, word));
+        }
+        return cardinality;
+    }
+    case ContainerType::run: {
+        std::size_t cardinality = 0;
+        std::size_t next_start = 0;
+        for (std::size_t run = 0; run < container.count; ++run) {
+            const auto [start, length] = run_at(container.data, run);
+            if (start < next_start || std::size_t{start} + length >= chunk_values) {
+                throw std::invalid_argument("board set run container out of order");
+            }
+            next_start = std::size_t{start} + length + 2;
+            cardinality += length + 1U;
+        }
+        return cardinality;
+    }
+    }
+    return 0;
+}
+
+BoardSetView::Bits BoardSetView::chunk_key(const std::size_t chunk) const noexcept
+{
+    return load<std::uint64_t>(chunks_ + chunk * chunk_entry_bytes);
+}
+
+std::size_t BoardSetView::chunk_rank(const std::size_t chunk) const noexcept
+{
+    if (chunk == chunk_count_) {
+        return size_ - loose_count_;
+    }
+    return load<std::uint64_t>(chunks_ + chunk * chunk_entry_bytes + 8);
+}
+
+BoardSetView::Container BoardSetView::container(const std::size_t chunk) const noexcept
+{
+    const auto packed = load<std::uint64_t>(chunks_ + chunk * chunk_entry_bytes + 16);
+    return {
+        static_cast<ContainerType>(packed_type(packed)),
+        packed_count(packed),
+        chunk_rank(chunk + 1) - chunk_rank(chunk),
+        data_ + packed_offset(packed),
+    };
+}
+
+std::size_t BoardSetView::lower_bound_chunk(const Bits key) const noexcept
+{
+    std::size_t first = 0;
+    std::size_t count = chunk_count_;
+    while (count > 0) {
+        const auto step = count / 2;
+        if (chunk_key(first + step) < key) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+BoardSetView::Bits BoardSetView::loose_board(const std::size_t index) const noexcept
+{
+    return load<std::uint64_t>(loose_ + index * loose_board_bytes);
+}
+
+std::size_t BoardSetView::lower_bound_loose(const Bits bits) const noexcept
+{
+    std::size_t first = 0;
+    std::size_t count = loose_count_;
+    while (count > 0) {
+        const auto step = count / 2;
+        if (loose_board(first + step) < bits) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+// Chunked boards below bits.
+std::size_t BoardSetView::chunked_rank(const Bits bits) const noexcept
+{
+    const auto key = chunk_key_of(bits);
+    const auto chunk = lower_bound_chunk(key);
+    if (chunk == chunk_count_ || chunk_key(chunk) != key) {
+        return chunk_rank(chunk);
+    }
+    return chunk_rank(chunk) + container_rank(container(chunk), low_bits(bits));
+}
+
+// The smallest key at or after the given chunk and loose board, or all ones past the end of both.
+BoardSetView::Bits BoardSetView::next_key(const std::size_t chunk, const std::size_t loose) const noexcept
+{
+    auto key = ~Bits{0};
+    if (chunk < chunk_count_) {
+        key = chunk_key(chunk);
+    }
+    if (loose < loose_count_) {
+        key = std::min(key, chunk_key_of(loose_board(loose)));
+    }
+    return key;
+}
+
+bool BoardSetView::has_chunk(const Bits key, const std::size_t chunk) const noexcept
+{
+    return chunk < chunk_count_ && chunk_key(chunk) == key;
+}
+
+// Appends the low bits of the boards with key, in order, whether they sit in a chunk or loose.
+void BoardSetView::append_values(const Bits key, const std::size_t chunk, std::size_t loose,
+                                 std::vector<std::uint16_t>& values) const
+{
+    if (has_chunk(key, chunk)) {
+        for_each_value(container(chunk), [&](const std::uint16_t value) { values.push_back(value); });
+        return;
+    }
+    for (; loose < loose_count_ && chunk_key_of(loose_board(loose)) == key; ++loose) {
+        values.push_back(low_bits(loose_board(loose)));
+    }
+}
+
+void BoardSetView::skip_key(const Bits key, std::size_t& chunk, std::size_t& loose) const noexcept
+{
+    if (has_chunk(key, chunk)) {
+        ++chunk;
+        return;
+    }
+    for (; loose < loose_count_ && chunk_key_of(loose_board(loose)) == key; ++loose) {
+    }
+}
+
+bool BoardSetView::container_contains(const Container& container, const std::uint16_t low) noexcept
+{
+    switch (container.type) {
+    case ContainerType::array: {
+        const auto index = container_rank(container, low);
+        return index < container.count && array_value(container.data, index) == low;
+    }
+    case ContainerType::bitmap:
+        return (bitmap_word(container.data, low / 64) >> (low % 64)) & 1U;
+    case ContainerType::run: {
+        std::size_t first = 0;
+        std::size_t count = container.count;
+        while (count > 0) {
+            const auto step = count / 2;
+            if (run_at(container.data, first + step)[0] <= low) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        if (first == 0) {
+            return false;
+        }
+        const auto [start, length] = run_at(container.data, first - 1);
+        return low - start <= length;
+    }
+    }
+    return false;
+}
+
+std::size_t BoardSetView::container_rank(const Container& container, const std::uint16_t low) noexcept
+{
+    switch (container.type) {
+    case ContainerType::array: {
+        std::size_t first = 0;
+        std::size_t count = container.count;
+        while (count > 0) {
+            const auto step = count / 2;
+            if (array_value(container.data, first + step) < low) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        return first;
+    }
+    case ContainerType::bitmap: {
+        std::size_t rank = 0;
+        const std::size_t full_words = low / 64;
+        for (std::size_t word = 0; word < full_words; ++word) {
+            rank += std::popcount(bitmap_word(container.data, word));
+        }
+        const auto below = (std::uint64_t{1} << (low % 64)) - 1;
+        return rank + std::popcount(bitmap_word(container.data, full_words) & below);
+    }
+    case ContainerType::run: {
+        std::size_t rank = 0;
+        for (std::size_t run = 0; run < container.count; ++run) {
+            const auto [start, length] = run_at(container.data, run);
+            if (start >= low) {
+                break;
+            }
+            rank += std::min<std::size_t>(length + 1U, low - start);
+        }
+        return rank;
+    }
+    }
+    return 0;
+}
+
+std::uint16_t BoardSetView::container_select(const Container& container, std::size_t index) noexcept
+{
+    assert(index < container.cardinality);
+    switch (container.type) {
+    case ContainerType::array:
+        return array_value(container.data, index);
+    case ContainerType::bitmap:
+        for (std::size_t word = 0; word < bitmap_words; ++word) {
+            const auto bits = bitmap_word(container.data, word);
+            const auto count = static_cast<std::size_t>(std::popcount(bits));
+            if (index < count) {
+                return static_cast<std::uint16_t>(word * 64 + select_in_word(bits, index));
+            }
+            index -= count;
+        }
+        break;
+    case ContainerType::run:
+        for (std::size_t run = 0; run < container.count; ++run) {
+            const auto [start, length] = run_at(container.data, run);
+            if (index <= length) {
+                return static_cast<std::uint16_t>(start + index);
+            }
+            index -= length + 1U;
+        }
+        break;
+    }
+    assert(!"select index out of range");
+    return 0;
+}
+
+void BoardSetView::container_to_bitmap(const Container& container, Bitmap& bitmap) noexcept
+{
+    if (container.type == ContainerType::bitmap) {
+        std::memcpy(bitmap.data(), container.data, sizeof(bitmap));
+        return;
+    }
+    bitmap.fill(0);
+    for_each_value(container, [&](const std::uint16_t value) { bitmap[value / 64] |= std::uint64_t{1} << (value % 64); });
+}
+
+bool BoardSetView::contains(const BitBoard board) const noexcept
+{
+    const auto bits = static_cast<Bits>(board.to_ullong());
+    const auto key = chunk_key_of(bits);
+    const auto chunk = lower_bound_chunk(key);
+    if (chunk < chunk_count_ && chunk_key(chunk) == key) {
+        return container_contains(container(chunk), low_bits(bits));
+    }
+    const auto loose = lower_bound_loose(bits);
+    return loose < loose_count_ && loose_board(loose) == bits;
+}
+
+std::size_t BoardSetView::rank(const BitBoard board) const noexcept
+{
+    const auto bits = static_cast<Bits>(board.to_ullong());
+    return chunked_rank(bits) + lower_bound_loose(bits);
+}
+
+BitBoard BoardSetView::select(const std::size_t index) const
+{
+    if (index >= size_) {
+        throw std::out_of_range("board set index out of range");
+    }
+    // The rank of loose board j in the whole set is j plus the chunked boards below it, which increases with j.
+    // Either one loose board has rank index, or the answer is the chunked board with as many loose boards below
+    // it as there are loose boards of smaller rank.
+    std::size_t loose_below = 0;
+    std::size_t count = loose_count_;
+    while (count > 0) {
+        const auto step = count / 2;
+        const auto j = loose_below + step;
+        const auto loose_rank = j + chunked_rank(loose_board(j));
+        if (loose_rank == index) {
+            return BitBoard{loose_board(j)};
+        }
+        if (loose_rank < index) {
+            loose_below = j + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    const auto chunked_index = index - loose_below;
+
+    std::size_t first = 0;
+    count = chunk_count_;
+    while (count > 0) {
+        const auto step = count / 2;
+        if (chunk_rank(first + step) <= chunked_index) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    const auto chunk = first - 1;
+    const auto low = container_select(container(chunk), chunked_index - chunk_rank(chunk));
+    return BitBoard{(chunk_key(chunk) << chunk_bits) | low};
+}
+
+std::vector<BitBoard> BoardSetView::to_vector() const
+{
+    std::vector<BitBoard> boards;
+    boards.reserve(size_);
+    for_each([&](const BitBoard board) { boards.push_back(board); });
+    return boards;
+}
+
+BoardSet::BoardSet() : BoardSet(BoardSetBuilder{}.finish()) {}
+
+BoardSet BoardSet::from_sorted(std::span<const BitBoard> boards)
+{
+    assert(std::is_sorted(boards.begin(), boards.end()));
+    BoardSetBuilder builder;
+    std::vector<std::uint16_t> values;
+    values.reserve(BoardSetView::chunk_values);
+    for (std::size_t begin = 0; begin < boards.size();) {
+        const auto key = chunk_key_of(boards[begin].to_ullong());
+        values.clear();
+        std::size_t end = begin;
+        for (; end < boards.size() && chunk_key_of(boards[end].to_ullong()) == key; ++end) {
+            const auto value = low_bits(boards[end].to_ullong());
+            if (values.empty() || values.back() != value) {
+                values.push_back(value);
+            }
+        }
+        builder.add_chunk(key, values);
+        begin = end;
+    }
+    return builder.finish();
+}
+
+BoardSet BoardSet::from_unsorted(std::vector<BitBoard> boards)
+{
+    radix_sort(boards);
+    return from_sorted(boards);
+}
+
+BoardSet BoardSet::from_bytes(std::span<const std::byte> bytes)
+{
+    const auto view = BoardSetView::from_bytes(bytes);
+    return BoardSet{std::vector<std::byte>(view.bytes().begin(), view.bytes().end())};
+}
+
+void BoardSet::write(std::ostream& out) const
+{
+    out.write(reinterpret_cast<const char*>(storage_.data()), static_cast<std::streamsize>(storage_.size()));
+}
+
+BoardSet BoardSet::set_union(const BoardSetView lhs, const BoardSetView rhs)
+{
+    BoardSetBuilder builder;
+    Bitmap lhs_bits;
+    Bitmap rhs_bits;
+    std::vector<std::uint16_t> lhs_values;
+    std::vector<std::uint16_t> rhs_values;
+    std::vector<std::uint16_t> values;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t lhs_loose = 0;
+    std::size_t rhs_loose = 0;
+    for (;;) {
+        const auto lhs_key = lhs.next_key(i, lhs_loose);
+        const auto rhs_key = rhs.next_key(j, rhs_loose);
+        const auto key = std::min(lhs_key, rhs_key);
+        if (key == ~Bits{0}) {
+            break;
+        }
+        if (lhs_key != rhs_key && (lhs.has_chunk(key, i) || rhs.has_chunk(key, j))) {
+            builder.add_container(key, lhs_key < rhs_key ? lhs.container(i++) : rhs.container(j++));
+            continue;
+        }
+        if (lhs.has_chunk(key, i) && rhs.has_chunk(key, j)) {
+            BoardSetView::container_to_bitmap(lhs.container(i++), lhs_bits);
+            BoardSetView::container_to_bitmap(rhs.container(j++), rhs_bits);
+            for (std::size_t word = 0; word < lhs_bits.size(); ++word) {
+                lhs_bits[word] |= rhs_bits[word];
+            }
+            builder.add_chunk(key, lhs_bits);
+            continue;
+        }
+        // Loose boards on at least one side: few enough values to merge directly.
+        lhs_values.clear();
+        rhs_values.clear();
+        values.clear();
+        if (lhs_key == key) {
+            lhs.append_values(key, i, lhs_loose, lhs_values);
+            lhs.skip_key(key, i, lhs_loose);
+        }
+        if (rhs_key == key) {
+            rhs.append_values(key, j, rhs_loose, rhs_values);
+            rhs.skip_key(key, j, rhs_loose);
+        }
+        std::set_union(lhs_values.begin(), lhs_values.end(), rhs_values.begin(), rhs_values.end(),
+                       std::back_inserter(values));
+        builder.add_chunk(key, values);
+    }
+    return builder.finish();
+}
+
+BoardSet BoardSet::set_intersection(const BoardSetView lhs, const BoardSetView rhs)
+{
+    BoardSetBuilder builder;
+    Bitmap lhs_bits;
+    Bitmap rhs_bits;
+    std::vector<std::uint16_t> lhs_values;
+    std::vector<std::uint16_t> rhs_values;
+    std::vector<std::uint16_t> values;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t lhs_loose = 0;
+    std::size_t rhs_loose = 0;
+    for (;;) {
+        const auto lhs_key = lhs.next_key(i, lhs_loose);
+        const auto rhs_key = rhs.next_key(j, rhs_loose);
+        if (lhs_key == ~Bits{0} || rhs_key == ~Bits{0}) {
+            break;
+        }
+        if (lhs_key < rhs_key) {
+            lhs.skip_key(lhs_key, i, lhs_loose);
+            continue;
+        }
+        if (rhs_key < lhs_key) {
+            rhs.skip_key(rhs_key, j, rhs_loose);
+            continue;
+        }
+        const auto key = lhs_key;
+        values.clear();
+        if (!lhs.has_chunk(key, i) || !rhs.has_chunk(key, j)) {
+            lhs_values.clear();
+            rhs_values.clear();
+            lhs.append_values(key, i, lhs_loose, lhs_values);
+            rhs.append_values(key, j, rhs_loose, rhs_values);
+            lhs.skip_key(key, i, lhs_loose);
+            rhs.skip_key(key, j, rhs_loose);
+            std::set_intersection(lhs_values.begin(), lhs_values.end(), rhs_values.begin(), rhs_values.end(),
+                                  std::back_inserter(values));
+            if (!values.empty()) {
+                builder.add_chunk(key, values);
+            }
+            continue;
+        }
+        const auto left = lhs.container(i++);
+        const auto right = rhs.container(j++);
+        if (left.type == ContainerType::array || right.type == ContainerType::array) {
+            const auto& small = left.cardinality <= right.cardinality ? left : right;
+            const auto& large = left.cardinality <= right.cardinality ? right : left;
+            BoardSetView::for_each_value(small, [&](const std::uint16_t value) {
+                if (BoardSetView::container_contains(large, value)) {
+                    values.push_back(value);
+                }
+            });
+            if (!values.empty()) {
+                builder.add_chunk(key, values);
+            }
+            continue;
+        }
+        BoardSetView::container_to_bitmap(left, lhs_bits);
+        BoardSetView::container_to_bitmap(right, rhs_bits);
+        for (std::size_t word = 0; word < lhs_bits.size(); ++word) {
+            lhs_bits[word] &= rhs_bits[word];
+        }
+        builder.add_chunk(key, lhs_bits);
+    }
+    return builder.finish();
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <vector>
+
+class BoardSet;
+
+class BoardSetView
+{
+  public:
+    using Bits = BitBoard::Bits;
+
+    enum class ContainerType : std::uint8_t
+    {
+        array,
+        bitmap,
+        run,
+    };
+
+    struct Container
+    {
+        ContainerType type;
+        std::size_t count;
+        std::size_t cardinality;
+        const std::byte* data;
+    };
+
+    static constexpr std::uint64_t format_magic = 0x0032'5445'5342'4242; // "BBSET2"
+    static constexpr std::size_t chunk_bits = 16;
+    static constexpr std::size_t chunk_values = std::size_t{1} << chunk_bits;
+    static constexpr std::size_t bitmap_words = chunk_values / 64;
+    static constexpr std::size_t max_array_values = 4096;
+    static constexpr std::size_t header_bytes = 5 * sizeof(std::uint64_t);
+    // Key, rank of the chunk's first board among chunked boards, and data offset packed with count and type.
+    static constexpr std::size_t chunk_entry_bytes = 3 * sizeof(std::uint64_t);
+    // A chunk whose boards take no more room stored whole than as an entry plus a container is not built: its
+    // boards are kept as loose 64-bit words instead. Random boards rarely share their high 48 bits, so most of
+    // them end up loose and cost what a sorted std::vector<BitBoard> would.
+    static constexpr std::size_t loose_board_bytes = sizeof(Bits);
+
+    constexpr BoardSetView() noexcept = default;
+
+    [[nodiscard]] static BoardSetView from_bytes(std::span<const std::byte> bytes);
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+    [[nodiscard]] std::size_t chunk_count() const noexcept
+    {
+        return chunk_count_;
+    }
+    [[nodiscard]] std::size_t loose_count() const noexcept
+    {
+        return loose_count_;
+    }
+
+    [[nodiscard]] bool contains(BitBoard board) const noexcept;
+    [[nodiscard]] std::size_t rank(BitBoard board) const noexcept;
+    [[nodiscard]] BitBoard select(std::size_t index) const;
+    [[nodiscard]] std::vector<BitBoard> to_vector() const;
+
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        std::size_t loose = 0;
+        for (std::size_t chunk = 0; chunk < chunk_count_; ++chunk) {
+            const Bits high = chunk_key(chunk) << chunk_bits;
+            for (; loose < loose_count_ && loose_board(loose) < high; ++loose) {
+                f(BitBoard{loose_board(loose)});
+            }
+            for_each_value(container(chunk), [&](const std::uint16_t low) { f(BitBoard{high | low}); });
+        }
+        for (; loose < loose_count_; ++loose) {
+            f(BitBoard{loose_board(loose)});
+        }
+    }
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+    {
+        return bytes_;
+    }
+
+  private:
+    friend class BoardSet;
+    friend class BoardSetBuilder;
+
+    std::span<const std::byte> bytes_;
+    std::size_t chunk_count_{0};
+    std::size_t loose_count_{0};
+    std::size_t size_{0};
+    const std::byte* chunks_{nullptr};
+    const std::byte* loose_{nullptr};
+    const std::byte* data_{nullptr};
+
+    explicit BoardSetView(std::span<const std::byte> bytes) noexcept;
+
+    [[nodiscard]] Bits chunk_key(std::size_t chunk) const noexcept;
+    [[nodiscard]] std::size_t chunk_rank(std::size_t chunk) const noexcept;
+    [[nodiscard]] Container container(std::size_t chunk) const noexcept;
+    [[nodiscard]] std::size_t lower_bound_chunk(Bits key) const noexcept;
+    [[nodiscard]] Bits loose_board(std::size_t index) const noexcept;
+    [[nodiscard]] std::size_t lower_bound_loose(Bits bits) const noexcept;
+    [[nodiscard]] std::size_t chunked_rank(Bits bits) const noexcept;
+    [[nodiscard]] Bits next_key(std::size_t chunk, std::size_t loose) const noexcept;
+    [[nodiscard]] bool has_chunk(Bits key, std::size_t chunk) const noexcept;
+    void append_values(Bits key, std::size_t chunk, std::size_t loose, std::vector<std::uint16_t>& values) const;
+    void skip_key(Bits key, std::size_t& chunk, std::size_t& loose) const noexcept;
+
+    [[nodiscard]] static std::size_t validated_cardinality(const Container& container);
+
+    [[nodiscard]] static bool container_contains(const Container& container, std::uint16_t low) noexcept;
+    [[nodiscard]] static std::size_t container_rank(const Container& container, std::uint16_t low) noexcept;
+    [[nodiscard]] static std::uint16_t container_select(const Container& container, std::size_t index) noexcept;
+    static void container_to_bitmap(const Container& container, std::array<std::uint64_t, bitmap_words>& bitmap) noexcept;
+
+    template <typename F>
+    static void for_each_value(const Container& container, F&& f);
+};
+
+class BoardSet
+{
+  public:
+    using Bits = BitBoard::Bits;
+
+    BoardSet();
+
+    [[nodiscard]] static BoardSet from_sorted(std::span<const BitBoard> boards);
+    [[nodiscard]] static BoardSet from_unsorted(std::vector<BitBoard> boards);
+    [[nodiscard]] static BoardSet from_bytes(std::span<const std::byte> bytes);
+
+    [[nodiscard]] BoardSetView view() const noexcept
+    {
+        return BoardSetView{storage_};
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return view().size();
+    }
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return view().empty();
+    }
+    [[nodiscard]] bool contains(const BitBoard board) const noexcept
+    {
+        return view().contains(board);
+    }
+    [[nodiscard]] std::size_t rank(const BitBoard board) const noexcept
+    {
+        return view().rank(board);
+    }
+    [[nodiscard]] BitBoard select(const std::size_t index) const
+    {
+        return view().select(index);
+    }
+    [[nodiscard]] std::vector<BitBoard> to_vector() const
+    {
+        return view().to_vector();
+    }
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+    {
+        return storage_;
+    }
+
+    void write(std::ostream& out) const;
+
+    [[nodiscard]] friend BoardSet operator|(const BoardSet& lhs, const BoardSet& rhs)
+    {
+        return set_union(lhs.view(), rhs.view());
+    }
+    [[nodiscard]] friend BoardSet operator&(const BoardSet& lhs, const BoardSet& rhs)
+    {
+        return set_intersection(lhs.view(), rhs.view());
+    }
+    [[nodiscard]] friend bool operator==(const BoardSet& lhs, const BoardSet& rhs)
+    {
+        return lhs.storage_ == rhs.storage_;
+    }
+
+    [[nodiscard]] static BoardSet set_union(BoardSetView lhs, BoardSetView rhs);
+    [[nodiscard]] static BoardSet set_intersection(BoardSetView lhs, BoardSetView rhs);
+
+  private:
+    friend class BoardSetBuilder;
+
+    std::vector<std::byte> storage_;
+
+    explicit BoardSet(std::vector<std::byte> storage) noexcept : storage_(std::move(storage)) {}
+};
+
+template <typename F>
+void BoardSetView::for_each_value(const Container& container, F&& f)
+{
+    switch (container.type) {
+    case ContainerType::array:
+        for (std::size_t i = 0; i < container.count; ++i) {
+            f(container_select(container, i));
+        }
+        break;
+    case ContainerType::bitmap:
+        for (std::size_t word = 0; word < bitmap_words; ++word) {
+            std::uint64_t bits{};
+            std::memcpy(&bits, container.data + word * sizeof(bits), sizeof(bits));
+            while (bits != 0) {
+                f(static_cast<std::uint16_t>(word * 64 + std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+        break;
+    case ContainerType::run:
+        for (std::size_t run = 0; run < container.count; ++run) {
+            std::array<std::uint16_t, 2> start_and_length{};
+            std::memcpy(start_and_length.data(), container.data + run * sizeof(start_and_length), sizeof(start_and_length));
+            for (std::size_t i = 0; i <= start_and_length[1]; ++i) {
+                f(static_cast<std::uint16_t>(start_and_length[0] + i));
+            }
+        }
+        break;
+    }
+}
@@ -0,0 +1,291 @@
+#include "board_sort.h"
+
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Bits = BitBoard::Bits;
+
+constexpr std::size_t digit_bits = CHAR_BIT;
+constexpr std::size_t n_buckets = std::size_t{1} << digit_bits;
+constexpr std::size_t n_digits = BitBoard::n_bits / digit_bits;
+constexpr std::size_t cache_line_size = 64;
+constexpr std::size_t line_boards = cache_line_size / sizeof(BitBoard);
+
+using Histogram = std::array<std::size_t, n_buckets>;
+
+std::size_t digit_of(const BitBoard board, const std::size_t shift) noexcept
+{
+    return (board.to_ullong() >> shift) & (n_buckets - 1);
+}
+
+class WriteCombiningScatter
+{
+  public:
+    void reset(std::span<BitBoard> destination, const Histogram& offsets) noexcept
+    {
+        destination_ = destination;
+        offsets_ = offsets;
+        fill_.fill(0);
+    }
+
+    void push(const std::size_t bucket, const BitBoard board) noexcept
+    {
+        auto& fill = fill_[bucket];
+        lines_[bucket][fill++] = board.to_ullong();
+        if (fill == line_boards) {
+            flush(bucket);
+        }
+    }
+
+    void flush_all() noexcept
+    {
+        for (std::size_t bucket = 0; bucket < n_buckets; ++bucket) {
+            flush(bucket);
+        }
+    }
+
+  private:
+    std::span<BitBoard> destination_;
+    Histogram offsets_{};
+    alignas(cache_line_size) std::array<std::array<Bits, line_boards>, n_buckets> lines_{};
+    std::array<std::uint8_t, n_buckets> fill_{};
+
+    void flush(const std::size_t bucket) noexcept
+    {
+        auto* out = destination_.data() + offsets_[bucket];
+        for (std::size_t i = 0; i < fill_[bucket]; ++i) {
+            out[i] = BitBoard{lines_[bucket][i]};
+        }
+        offsets_[bucket] += fill_[bucket];
+        fill_[bucket] = 0;
+    }
+};
+
+Histogram exclusive_prefix_sum(const Histogram& counts, std::size_t start = 0) noexcept
+{
+    Histogram offsets{};
+    for (std::size_t bucket = 0; bucket < n_buckets; ++bucket) {
+        offsets[bucket] = start;
+        start += counts[bucket];
+    }
+    return offsets;
+}
+
+unsigned thread_count(const SortUniqueOptions& options) noexcept
+{
+    if (options.threads != 0) {
+        return options.threads;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+template <typename F>
+void parallel_for(const unsigned threads, const std::size_t n_tasks, F&& task)
+{
+    std::atomic<std::size_t> next{0};
+    const auto work = [&] {
+        for (auto i = next.fetch_add(1); i < n_tasks; i = next.fetch_add(1)) {
+            task(i);
+        }
+    };
+    std::vector<std::thread> workers;
+    const auto n_workers = std::min<std::size_t>(threads, n_tasks);
+    for (std::size_t i = 1; i < n_workers; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::span<const BitBoard> slice(std::span<const BitBoard> boards, const std::size_t part, const std::size_t parts)
+{
+    const auto begin = boards.size() * part / parts;
+    const auto end = boards.size() * (part + 1) / parts;
+    return boards.subspan(begin, end - begin);
+}
+
+class Splitters
+{
+  public:
+    explicit Splitters(std::span<const BitBoard> boards)
+    {
+        constexpr std::size_t oversampling = 16;
+        const auto n_samples = std::min(boards.size(), n_buckets * oversampling);
+        std::vector<BitBoard> samples;
+        samples.reserve(n_samples);
+        for (std::size_t i = 0; i < n_samples; ++i) {
+            samples.push_back(boards[i * boards.size() / n_samples]);
+        }
+        std::sort(samples.begin(), samples.end());
+        splitters_.fill(~Bits{0});
+        for (std::size_t bucket = 1; bucket < n_buckets && !samples.empty(); ++bucket) {
+            splitters_[bucket - 1] = samples[bucket * samples.size() / n_buckets].to_ullong();
+        }
+    }
+
+    [[nodiscard]] std::size_t bucket_of(const BitBoard board) const noexcept
+    {
+        const auto bits = board.to_ullong();
+        std::size_t bucket = 0;
+        for (std::size_t step = n_buckets / 2; step > 0; step /= 2) {
+            bucket += (splitters_[bucket + step - 1] <= bits) ? step : 0;
+        }
+        return bucket;
+    }
+
+  private:
+    std::array<Bits, n_buckets - 1> splitters_;
+};
+
+struct Partitions
+{
+    std::vector<BitBoard> boards;
+    Histogram offsets;
+    Histogram counts;
+};
+
+Partitions partition(std::span<const BitBoard> boards, const SortUniqueOptions& options)
+{
+    const auto threads = thread_count(options);
+    std::vector<BitBoard> canonical;
+    if (options.canonicalize) {
+        canonical.resize(boards.size());
+        parallel_for(threads, threads, [&](const std::size_t part) {
+            auto out = canonical.begin() + static_cast<std::ptrdiff_t>(boards.size() * part / threads);
+            for (const auto board : slice(boards, part, threads)) {
+                *out++ = BitBoard::canonical(board);
+            }
+        });
+        boards = canonical;
+    }
+
+    const Splitters splitters{boards};
+    std::vector<Histogram> histograms(threads);
+    parallel_for(threads, threads, [&](const std::size_t part) {
+        auto& histogram = histograms[part];
+        histogram.fill(0);
+        for (const auto board : slice(boards, part, threads)) {
+            ++histogram[splitters.bucket_of(board)];
+        }
+    });
+
+    Partitions partitions{std::vector<BitBoard>(boards.size()), {}, {}};
+    partitions.counts.fill(0);
+    for (const auto& histogram : histograms) {
+        for (std::size_t bucket = 0; bucket < n_buckets; ++bucket) {
+            partitions.counts[bucket] += histogram[bucket];
+        }
+    }
+    partitions.offsets = exclusive_prefix_sum(partitions.counts);
+
+    std::vector<Histogram> starts(threads);
+    auto running = partitions.offsets;
+    for (std::size_t part = 0; part < threads; ++part) {
+        starts[part] = running;
+        for (std::size_t bucket = 0; bucket < n_buckets; ++bucket) {
+            running[bucket] += histograms[part][bucket];
+        }
+    }
+    parallel_for(threads, threads, [&](const std::size_t part) {
+        auto scatter = std::make_unique<WriteCombiningScatter>();
+        scatter->reset(partitions.boards, starts[part]);
+        for (const auto board : slice(boards, part, threads)) {
+            scatter->push(splitters.bucket_of(board), board);
+        }
+        scatter->flush_all();
+    });
+    return partitions;
+}
+
+template <typename Emit>
+std::size_t sort_unique_partitions(std::span<const BitBoard> boards, const SortUniqueOptions& options, Emit&& emit)
+{
+    auto partitions = partition(boards, options);
+    std::array<std::size_t, n_buckets> unique_counts{};
+    parallel_for(thread_count(options), n_buckets, [&](const std::size_t bucket) {
+        const auto part =
+            std::span<BitBoard>{partitions.boards}.subspan(partitions.offsets[bucket], partitions.counts[bucket]);
+        radix_sort(part);
+        unique_counts[bucket] = static_cast<std::size_t>(std::unique(part.begin(), part.end()) - part.begin());
+    });
+
+    std::size_t total = 0;
+    for (std::size_t bucket = 0; bucket < n_buckets; ++bucket) {
+        emit(std::span<const BitBoard>{partitions.boards}.subspan(partitions.offsets[bucket], unique_counts[bucket]));
+        total += unique_counts[bucket];
+    }
+    return total;
+}
+
+} // namespace
+
+void radix_sort(std::span<BitBoard> boards)
+{
+    std::vector<BitBoard> scratch(boards.size());
+    radix_sort(boards, scratch);
+}
+
+void radix_sort(std::span<BitBoard> boards, std::span<BitBoard> scratch)
+{
+    assert(scratch.size() >= boards.size());
+    std::array<Histogram, n_digits> histograms{};
+    for (const auto board : boards) {
+        for (std::size_t digit = 0; digit < n_digits; ++digit) {
+            ++histograms[digit][digit_of(board, digit * digit_bits)];
+        }
+    }
+
+    auto source = boards;
+    auto destination = scratch.first(boards.size());
+    auto scatter = std::make_unique<WriteCombiningScatter>();
+    for (std::size_t digit = 0; digit < n_digits; ++digit) {
+        const auto& histogram = histograms[digit];
+        if (std::find(histogram.begin(), histogram.end(), boards.size()) != histogram.end()) {
+            continue;
+        }
+        const auto shift = digit * digit_bits;
+        scatter->reset(destination, exclusive_prefix_sum(histogram));
+        for (const auto board : source) {
+            scatter->push(digit_of(board, shift), board);
+        }
+        scatter->flush_all();
+        std::swap(source, destination);
+    }
+    if (source.data() != boards.data()) {
+        std::copy(source.begin(), source.end(), boards.begin());
+    }
+}
+
+std::vector<BitBoard> sort_unique(std::span<const BitBoard> boards, const SortUniqueOptions& options)
+{
+    std::vector<BitBoard> sorted;
+    sorted.reserve(boards.size());
+    sort_unique_partitions(boards, options, [&](std::span<const BitBoard> part) {
+        sorted.insert(sorted.end(), part.begin(), part.end());
+    });
+    return sorted;
+}
+
+std::size_t write_sort_unique(std::span<const BitBoard> boards, std::ostream& out, const SortUniqueOptions& options)
+{
+    static_assert(sizeof(BitBoard) == sizeof(Bits), "boards are written as raw words");
+    return sort_unique_partitions(boards, options, [&](std::span<const BitBoard> part) {
+        out.write(reinterpret_cast<const char*>(part.data()), static_cast<std::streamsize>(part.size_bytes()));
+    });
+}
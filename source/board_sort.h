@@ -0,0 +1,23 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+
+#include <ostream>
+#include <span>
+#include <vector>
+
+struct SortUniqueOptions
+{
+    unsigned threads{0};
+    bool canonicalize{false};
+};
+
+void radix_sort(std::span<BitBoard> boards);
+
+void radix_sort(std::span<BitBoard> boards, std::span<BitBoard> scratch);
+
+[[nodiscard]] std::vector<BitBoard> sort_unique(std::span<const BitBoard> boards, const SortUniqueOptions& options = {});
+
+std::size_t write_sort_unique(std::span<const BitBoard> boards, std::ostream& out, const SortUniqueOptions& options = {});
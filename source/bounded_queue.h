@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free multi-producer multi-consumer queue (Vyukov's sequenced ring).
+// Consumers detect end of stream once every registered producer has called close_producer().
+template <typename T>
+class BoundedQueue
+{
+  public:
+    explicit BoundedQueue(const std::size_t capacity, const unsigned producers = 1)
+        : cells_(std::bit_ceil(std::max<std::size_t>(capacity, 2))), mask_(cells_.size() - 1), producers_(producers)
+    {
+        for (std::size_t i = 0; i < cells_.size(); ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return cells_.size();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        const auto head = head_.load(std::memory_order_relaxed);
+        return tail >= head ? tail - head : 0;
+    }
+
+    [[nodiscard]] bool try_push(T& value) noexcept
+    {
+        auto position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = cells_[position & mask_];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    [[nodiscard]] bool try_pop(T& value) noexcept
+    {
+        auto position = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = cells_[position & mask_];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+            if (difference == 0) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void close_producer() noexcept
+    {
+        producers_.fetch_sub(1, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool closed() const noexcept
+    {
+        return producers_.load(std::memory_order_acquire) == 0;
+    }
+
+  private:
+    struct alignas(64) Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::vector<Cell> cells_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::atomic<unsigned> producers_;
+};
@@ -0,0 +1,124 @@
+#include "cpu_features.h"
+
+#include "kernels.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BITBOARD_X86_DISPATCH 1
+#include <cpuid.h>
+#endif
+
+namespace {
+
+constexpr std::array<std::string_view, 5> level_names{"generic", "popcnt", "bmi2", "avx2", "avx512"};
+
+CpuFeatures detect_cpu_features() noexcept
+{
+    CpuFeatures features;
+#if defined(BITBOARD_X86_DISPATCH)
+    __builtin_cpu_init();
+    features.popcnt = __builtin_cpu_supports("popcnt");
+    features.bmi2 = __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.avx512f = __builtin_cpu_supports("avx512f");
+    features.avx512bw = __builtin_cpu_supports("avx512bw");
+    features.avx512vl = __builtin_cpu_supports("avx512vl");
+    features.avx512vpopcntdq = __builtin_cpu_supports("avx512vpopcntdq");
+    features.avx512vbmi2 = __builtin_cpu_supports("avx512vbmi2");
+
+    unsigned int eax{};
+    unsigned int ebx{};
+    unsigned int ecx{};
+    unsigned int edx{};
+    if (__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx)) {
+        constexpr unsigned int lzcnt_bit = 1U << 5;
+        features.lzcnt = (ecx & lzcnt_bit) != 0;
+    }
+#endif
+    return features;
+}
+
+CpuLevel level_of(const CpuFeatures& features) noexcept
+{
+    if (!features.popcnt || !features.lzcnt) {
+        return CpuLevel::generic;
+    }
+    if (!features.bmi2) {
+        return CpuLevel::popcnt;
+    }
+    if (!features.avx2) {
+        return CpuLevel::bmi2;
+    }
+    if (!features.avx512f || !features.avx512bw || !features.avx512vl || !features.avx512vpopcntdq) {
+        return CpuLevel::avx2;
+    }
+    return CpuLevel::avx512;
+}
+
+CpuLevel startup_level() noexcept
+{
+    const auto detected = detected_cpu_level();
+    if (const char* requested = std::getenv("BITBOARD_CPU_LEVEL")) {
+        if (const auto level = cpu_level_from_string(requested)) {
+            return std::min(*level, detected);
+        }
+    }
+    return detected;
+}
+
+std::atomic<CpuLevel>& active_level() noexcept
+{
+    static std::atomic<CpuLevel> level{startup_level()};
+    return level;
+}
+
+} // namespace
+
+const CpuFeatures& detected_cpu_features() noexcept
+{
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+}
+
+CpuLevel detected_cpu_level() noexcept
+{
+    static const CpuLevel level = level_of(detected_cpu_features());
+    return level;
+}
+
+CpuLevel cpu_level() noexcept
+{
+    return active_level().load(std::memory_order_relaxed);
+}
+
+void force_cpu_level(const CpuLevel level) noexcept
+{
+    const auto clamped = std::min(level, detected_cpu_level());
+    active_level().store(clamped, std::memory_order_relaxed);
+    select_kernels(clamped);
+}
+
+void reset_cpu_level() noexcept
+{
+    force_cpu_level(startup_level());
+}
+
+std::string_view to_string(const CpuLevel level) noexcept
+{
+    return level_names[static_cast<std::size_t>(level)];
+}
+
+std::optional<CpuLevel> cpu_level_from_string(const std::string_view name) noexcept
+{
+    const auto found = std::find(level_names.begin(), level_names.end(), name);
+    if (found == level_names.end()) {
+        return std::nullopt;
+    }
+    return static_cast<CpuLevel>(found - level_names.begin());
+}
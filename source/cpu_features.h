@@ -0,0 +1,40 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+enum class CpuLevel
+{
+    generic,
+    popcnt,
+    bmi2,
+    avx2,
+    avx512,
+};
+
+struct CpuFeatures
+{
+    bool popcnt{false};
+    bool lzcnt{false};
+    bool bmi2{false};
+    bool avx2{false};
+    bool avx512f{false};
+    bool avx512bw{false};
+    bool avx512vl{false};
+    bool avx512vpopcntdq{false};
+    bool avx512vbmi2{false};
+};
+
+[[nodiscard]] const CpuFeatures& detected_cpu_features() noexcept;
+
+[[nodiscard]] CpuLevel detected_cpu_level() noexcept;
+
+[[nodiscard]] CpuLevel cpu_level() noexcept;
+
+void force_cpu_level(CpuLevel level) noexcept;
+
+void reset_cpu_level() noexcept;
+
+[[nodiscard]] std::string_view to_string(CpuLevel level) noexcept;
+
+[[nodiscard]] std::optional<CpuLevel> cpu_level_from_string(std::string_view name) noexcept;
@@ -0,0 +1,16 @@
+#include "evaluation.h"
+
+#include "kernels.h"
+
+#include <cassert>
+
+#include <span>
+
+void evaluate_bit_planes(
+    std::span<const BitBoard::Bits> planes, std::span<const BitBoard> boards, std::span<Score> scores
+) noexcept
+{
+    assert(!planes.empty());
+    assert(scores.size() >= boards.size());
+    kernels().evaluate_bit_planes(planes, boards, scores);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cassert>
+#include <climits>
+#include <cstdint>
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <span>
+
+using Score = std::int32_t;
+
+template <typename T>
+concept SquareWeight = std::same_as<T, std::int8_t> || std::same_as<T, std::int16_t>;
+
+void evaluate_bit_planes(
+    std::span<const BitBoard::Bits> planes, std::span<const BitBoard> boards, std::span<Score> scores
+) noexcept;
+
+template <SquareWeight Weight>
+class SquareWeights
+{
+  public:
+    using Position = BitBoard::Position;
+    using Bits = BitBoard::Bits;
+
+    static constexpr std::size_t n_planes = sizeof(Weight) * CHAR_BIT;
+    static constexpr std::size_t n_lanes = sizeof(Bits);
+    static constexpr std::size_t lane_values = 1U << CHAR_BIT;
+
+    constexpr explicit SquareWeights(const std::array<Weight, BitBoard::n_bits>& weights) noexcept
+        : weights_(weights), lane_tables_{}, planes_{}
+    {
+        for (std::size_t bit = 0; bit < BitBoard::n_bits; ++bit) {
+            const Weight weight = weight_of_bit(bit);
+            const auto pattern = static_cast<std::make_unsigned_t<Weight>>(weight);
+            for (std::size_t plane = 0; plane < n_planes; ++plane) {
+                if ((pattern >> plane) & 1U) {
+                    planes_[plane] |= Bits{1} << bit;
+                }
+            }
+        }
+        for (std::size_t lane = 0; lane < n_lanes; ++lane) {
+            for (std::size_t value = 1; value < lane_values; ++value) {
+                const auto lowest = static_cast<std::size_t>(std::countr_zero(value));
+                lane_tables_[lane][value] =
+                    lane_tables_[lane][value & (value - 1)] + weight_of_bit(lane * CHAR_BIT + lowest);
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr Weight operator[](const Position& position) const
+    {
+        return weights_[position.x() * BitBoard::board_size + position.y()];
+    }
+
+    [[nodiscard]] constexpr Score evaluate(const BitBoard board) const noexcept
+    {
+        Bits bits = board.to_ullong();
+        Score score = 0;
+        for (std::size_t lane = 0; lane < n_lanes; ++lane) {
+            score += lane_tables_[lane][bits & (lane_values - 1)];
+            bits >>= CHAR_BIT;
+        }
+        return score;
+    }
+
+    [[nodiscard]] constexpr Score evaluate_bit_sliced(const BitBoard board) const noexcept
+    {
+        const Bits bits = board.to_ullong();
+        Score score = 0;
+        for (std::size_t plane = 0; plane + 1 < n_planes; ++plane) {
+            score += std::popcount(bits & planes_[plane]) << plane;
+        }
+        score -= std::popcount(bits & planes_[n_planes - 1]) << (n_planes - 1);
+        return score;
+    }
+
+    void evaluate(std::span<const BitBoard> boards, std::span<Score> scores) const noexcept
+    {
+        assert(scores.size() >= boards.size());
+        evaluate_bit_planes(planes_, boards, scores);
+    }
+
+    [[nodiscard]] constexpr const std::array<Bits, n_planes>& bit_planes() const noexcept
+    {
+        return planes_;
+    }
+
+  private:
+    std::array<Weight, BitBoard::n_bits> weights_;
+    std::array<std::array<Score, lane_values>, n_lanes> lane_tables_;
+    std::array<Bits, n_planes> planes_;
+
+    [[nodiscard]] constexpr Weight weight_of_bit(const std::size_t bit) const noexcept
+    {
+        return weights_[BitBoard::n_bits - 1 - bit];
+    }
+};
@@ -0,0 +1,179 @@
+#include "instrumentation.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#if defined(BITBOARD_INSTRUMENTATION_TIMING) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif defined(BITBOARD_INSTRUMENTATION_TIMING)
+#include <chrono>
+#endif
+
+namespace {
+
+constexpr std::array<std::string_view, n_probes> probe_names{
+    "string_constructor",
+    "from_position_error",
+    "shift_dynamic",
+    "shift_offset",
+    "dilate_dynamic",
+    "on_edge_dynamic",
+    "on_any_edge",
+    "neighbors",
+    "to_position_vector",
+    "to_bitboard_vector",
+    "to_position_set",
+    "to_string",
+};
+
+constexpr std::size_t cache_line_size = 64;
+
+struct alignas(cache_line_size) ThreadCounters
+{
+    std::array<std::atomic<std::uint64_t>, n_probes> calls{};
+    std::array<std::atomic<std::uint64_t>, n_probes> cycles{};
+};
+
+class Registry
+{
+  public:
+    void attach(ThreadCounters* counters)
+    {
+        const std::lock_guard lock{mutex_};
+        live_.push_back(counters);
+    }
+
+    void detach(ThreadCounters* counters)
+    {
+        const std::lock_guard lock{mutex_};
+        accumulate(retired_, *counters);
+        live_.erase(std::remove(live_.begin(), live_.end(), counters), live_.end());
+    }
+
+    InstrumentationSnapshot snapshot()
+    {
+        const std::lock_guard lock{mutex_};
+        auto totals = retired_;
+        for (const auto* counters : live_) {
+            accumulate(totals, *counters);
+        }
+        return totals;
+    }
+
+    void reset()
+    {
+        const std::lock_guard lock{mutex_};
+        retired_ = {};
+        for (auto* counters : live_) {
+            for (std::size_t i = 0; i < n_probes; ++i) {
+                counters->calls[i].store(0, std::memory_order_relaxed);
+                counters->cycles[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<ThreadCounters*> live_;
+    InstrumentationSnapshot retired_{};
+
+    static void accumulate(InstrumentationSnapshot& totals, const ThreadCounters& counters)
+    {
+        for (std::size_t i = 0; i < n_probes; ++i) {
+            totals[i].calls += counters.calls[i].load(std::memory_order_relaxed);
+            totals[i].cycles += counters.cycles[i].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+#if defined(BITBOARD_INSTRUMENTATION)
+class ThreadRegistration
+{
+  public:
+    ThreadRegistration()
+    {
+        registry().attach(&counters_);
+    }
+    ThreadRegistration(const ThreadRegistration&) = delete;
+    ThreadRegistration& operator=(const ThreadRegistration&) = delete;
+    ~ThreadRegistration()
+    {
+        registry().detach(&counters_);
+    }
+
+    ThreadCounters& counters() noexcept
+    {
+        return counters_;
+    }
+
+  private:
+    ThreadCounters counters_;
+};
+
+void bump(std::atomic<std::uint64_t>& counter, const std::uint64_t amount) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+#endif
+
+} // namespace
+
+InstrumentationSnapshot instrumentation_snapshot()
+{
+    return registry().snapshot();
+}
+
+void reset_instrumentation()
+{
+    registry().reset();
+}
+
+void export_instrumentation(std::ostream& out, const InstrumentationSnapshot& snapshot)
+{
+    out << "probe,calls,cycles\n";
+    for (std::size_t i = 0; i < n_probes; ++i) {
+        out << probe_names[i] << ',' << snapshot[i].calls << ',' << snapshot[i].cycles << '\n';
+    }
+}
+
+std::string_view to_string(const Probe probe) noexcept
+{
+    return probe_names[static_cast<std::size_t>(probe)];
+}
+
+#if defined(BITBOARD_INSTRUMENTATION)
+
+void record_probe(const Probe probe, const std::uint64_t cycles) noexcept
+{
+    static thread_local ThreadRegistration registration;
+    auto& counters = registration.counters();
+    const auto i = static_cast<std::size_t>(probe);
+    bump(counters.calls[i], 1);
+    bump(counters.cycles[i], cycles);
+}
+
+std::uint64_t probe_clock() noexcept
+{
+#if defined(BITBOARD_INSTRUMENTATION_TIMING) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#elif defined(BITBOARD_INSTRUMENTATION_TIMING)
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#else
+    return 0;
+#endif
+}
+
+#endif
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+enum class Probe
+{
+    string_constructor,
+    from_position_error,
+    shift_dynamic,
+    shift_offset,
+    dilate_dynamic,
+    on_edge_dynamic,
+    on_any_edge,
+    neighbors,
+    to_position_vector,
+    to_bitboard_vector,
+    to_position_set,
+    to_string,
+};
+
+inline constexpr std::size_t n_probes = static_cast<std::size_t>(Probe::to_string) + 1;
+
+struct ProbeStats
+{
+    std::uint64_t calls{0};
+    std::uint64_t cycles{0};
+};
+
+using InstrumentationSnapshot = std::array<ProbeStats, n_probes>;
+
+[[nodiscard]] constexpr bool instrumentation_enabled() noexcept
+{
+#if defined(BITBOARD_INSTRUMENTATION)
+    return true;
+#else
+    return false;
+#endif
+}
+
+[[nodiscard]] InstrumentationSnapshot instrumentation_snapshot();
+
+void reset_instrumentation();
+
+void export_instrumentation(std::ostream& out, const InstrumentationSnapshot& snapshot);
+
+[[nodiscard]] std::string_view to_string(Probe probe) noexcept;
+
+#if defined(BITBOARD_INSTRUMENTATION)
+
+void record_probe(Probe probe, std::uint64_t cycles) noexcept;
+
+[[nodiscard]] std::uint64_t probe_clock() noexcept;
+
+class ScopedProbe
+{
+  public:
+    explicit ScopedProbe(const Probe probe) noexcept : probe_(probe), start_(probe_clock()) {}
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+    ~ScopedProbe()
+    {
+        record_probe(probe_, probe_clock() - start_);
+    }
+
+  private:
+    Probe probe_;
+    std::uint64_t start_;
+};
+
+#define BITBOARD_PROBE_CONCAT_(a, b) a##b
+#define BITBOARD_PROBE_NAME_(line) BITBOARD_PROBE_CONCAT_(bitboard_probe_, line)
+#define BITBOARD_PROBE(probe) const ScopedProbe BITBOARD_PROBE_NAME_(__LINE__){probe}
+#define BITBOARD_COUNT(probe)                                                                                          \
+    do {                                                                                                               \
+        if (!std::is_constant_evaluated()) {                                                                           \
+            record_probe(probe, 0);                                                                                    \
+        }                                                                                                              \
+    } while (false)
+
+#else
+
+#define BITBOARD_PROBE(probe) static_cast<void>(0)
+#define BITBOARD_COUNT(probe) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,873 @@
+#include "kernels.h"
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "evaluation.h"
+#include "move_list.h"
+#include "reachability.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <iterator>
+#include <span>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BITBOARD_X86_KERNELS 1
+#include <immintrin.h>
+#define BITBOARD_TARGET(isa) __attribute__((target(isa)))
+#define BITBOARD_INLINE inline __attribute__((always_inline))
+#else
+#define BITBOARD_INLINE inline
+#endif
+
+namespace {
+
+using Bits = BitBoard::Bits;
+
+static_assert(sizeof(BitBoard) == sizeof(Bits), "BitBoard batches are loaded as raw words");
+
+BITBOARD_INLINE std::size_t count_total_body(std::span<const BitBoard> boards) noexcept
+{
+    std::size_t total = 0;
+    for (const auto board : boards) {
+        total += std::popcount(board.to_ullong());
+    }
+    return total;
+}
+
+BITBOARD_INLINE std::size_t count_words_body(std::span<const Bits> words) noexcept
+{
+    std::size_t total = 0;
+    for (const auto word : words) {
+        total += std::popcount(word);
+    }
+    return total;
+}
+
+BITBOARD_INLINE void count_each_body(std::span<const BitBoard> boards, std::span<std::uint8_t> counts) noexcept
+{
+    for (std::size_t i = 0; i < boards.size(); ++i) {
+        counts[i] = static_cast<std::uint8_t>(std::popcount(boards[i].to_ullong()));
+    }
+}
+
+BITBOARD_INLINE std::size_t
+square_indices_body(const BitBoard board, std::span<std::uint8_t, BitBoard::n_bits> indices) noexcept
+{
+    constexpr Bits top_left = Bits{1} << (BitBoard::n_bits - 1);
+    Bits bits = board.to_ullong();
+    std::size_t n = 0;
+    while (bits != 0) {
+        const auto index = std::countl_zero(bits);
+        indices[n++] = static_cast<std::uint8_t>(index);
+        bits &= ~(top_left >> index);
+    }
+    return n;
+}
+
+BITBOARD_INLINE Move move_to_bit(const std::uint16_t base, const Bits targets) noexcept
+{
+    const auto to = BitBoard::n_bits - 1 - static_cast<std::size_t>(std::countr_zero(targets));
+    return Move{static_cast<std::uint16_t>(base | (to << Move::square_bits))};
+}
+
+// Four moves per iteration: countr_zero is tzcnt and targets &= targets - 1 is blsr where BMI is enabled.
+BITBOARD_INLINE std::size_t serialize_moves_body(const Move base, Bits targets, std::span<Move> out) noexcept
+{
+    const auto n = static_cast<std::size_t>(std::popcount(targets));
+    assert(n <= out.size());
+    Move* moves = out.data();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        moves[i] = move_to_bit(base.bits(), targets);
+        targets &= targets - 1;
+        moves[i + 1] = move_to_bit(base.bits(), targets);
+        targets &= targets - 1;
+        moves[i + 2] = move_to_bit(base.bits(), targets);
+        targets &= targets - 1;
+        moves[i + 3] = move_to_bit(base.bits(), targets);
+        targets &= targets - 1;
+    }
+    for (; i < n; ++i) {
+        moves[i] = move_to_bit(base.bits(), targets);
+        targets &= targets - 1;
+    }
+    return n;
+}
+
+BITBOARD_INLINE Score evaluate_board_body(std::span<const Bits> planes, const Bits bits) noexcept
+{
+    const auto sign_plane = planes.size() - 1;
+    Score score = 0;
+    for (std::size_t plane = 0; plane < sign_plane; ++plane) {
+        score += std::popcount(bits & planes[plane]) << plane;
+    }
+    score -= std::popcount(bits & planes[sign_plane]) << sign_plane;
+    return score;
+}
+
+BITBOARD_INLINE void evaluate_bit_planes_body(
+    std::span<const Bits> planes, std::span<const BitBoard> boards, std::span<Score> scores, std::size_t i
+) noexcept
+{
+    for (; i < boards.size(); ++i) {
+        scores[i] = evaluate_board_body(planes, boards[i].to_ullong());
+    }
+}
+
+BITBOARD_INLINE Bits row_neighbors_word(
+    const Bits above, const Bits row, const Bits below, const Bits row_mask, const Neighborhood neighborhood
+) noexcept
+{
+    const Bits vertical = above | below;
+    Bits result = 0;
+    if (neighborhood != Neighborhood::diagonal) {
+        result |= (row << 1) | (row >> 1) | vertical;
+    }
+    if (neighborhood != Neighborhood::cardinal) {
+        result |= (vertical << 1) | (vertical >> 1);
+    }
+    return result & row_mask;
+}
+
+BITBOARD_INLINE void row_neighbors_body(
+    std::span<const Bits> words,
+    std::span<Bits> out,
+    const std::size_t n_rows,
+    const Bits row_mask,
+    const Neighborhood neighborhood,
+    std::size_t row
+) noexcept
+{
+    assert(n_rows + 2 <= words.size() && words.size() == out.size());
+    for (; row <= n_rows; ++row) {
+        out[row] = row_neighbors_word(words[row - 1], words[row], words[row + 1], row_mask, neighborhood);
+    }
+}
+
+std::size_t count_total_generic(std::span<const BitBoard> boards) noexcept
+{
+    return count_total_body(boards);
+}
+
+std::size_t count_words_generic(std::span<const Bits> words) noexcept
+{
+    return count_words_body(words);
+}
+
+void count_each_generic(std::span<const BitBoard> boards, std::span<std::uint8_t> counts) noexcept
+{
+    count_each_body(boards, counts);
+}
+
+std::size_t square_indices_generic(const BitBoard board, std::span<std::uint8_t, BitBoard::n_bits> indices) noexcept
+{
+    return square_indices_body(board, indices);
+}
+
+Bits extract_bits_generic(const Bits bits, Bits mask) noexcept
+{
+    Bits result = 0;
+    for (Bits out = 1; mask != 0; out <<= 1) {
+        if (bits & mask & -mask) {
+            result |= out;
+        }
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+Bits deposit_bits_generic(const Bits bits, Bits mask) noexcept
+{
+    Bits result = 0;
+    for (Bits in = 1; mask != 0; in <<= 1) {
+        if (bits & in) {
+            result |= mask & -mask;
+        }
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+// Position of the n-th set bit within each byte value.
+constexpr auto select_in_byte = [] {
+    std::array<std::array<std::uint8_t, 8>, 256> table{};
+    for (std::size_t value = 0; value < table.size(); ++value) {
+        std::size_t n = 0;
+        for (std::uint8_t bit = 0; bit < 8; ++bit) {
+            if ((value >> bit) & 1) {
+                table[value][n++] = bit;
+            }
+        }
+    }
+    return table;
+}();
+
+// Broadword select: byte-wise prefix counts locate the byte holding the bit, a table finishes inside it.
+Bits select_bit_generic(const Bits bits, const std::size_t n) noexcept
+{
+    constexpr Bits ones = 0x0101010101010101;
+    constexpr Bits high_bits = 0x8080808080808080;
+    Bits counts = bits - ((bits >> 1) & 0x5555555555555555);
+    counts = (counts & 0x3333333333333333) + ((counts >> 2) & 0x3333333333333333);
+    counts = (counts + (counts >> 4)) & 0x0f0f0f0f0f0f0f0f;
+    const Bits prefix = counts * ones;
+    if (n >= (prefix >> 56)) {
+        return 0;
+    }
+    const Bits not_past = ((n * ones) | high_bits) - prefix;
+    const auto byte = static_cast<std::size_t>((((not_past & high_bits) >> 7) * ones) >> 56);
+    const auto before = byte == 0 ? 0 : static_cast<std::size_t>((prefix >> (8 * byte - 8)) & 0xff);
+    const auto value = static_cast<std::size_t>((bits >> (8 * byte)) & 0xff);
+    return Bits{1} << (8 * byte + select_in_byte[value][n - before]);
+}
+
+template <Neighborhood N>
+BITBOARD_INLINE void reach_batch_body(std::span<const ReachQuery> queries, std::span<ReachResult> results) noexcept
+{
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        results[i] = reach(queries[i], [](const BitBoard frontier) { return step(frontier, N); });
+    }
+}
+
+void reach_batch_generic(
+    std::span<const ReachQuery> queries, std::span<ReachResult> results, const Neighborhood neighborhood
+) noexcept
+{
+    assert(results.size() >= queries.size());
+    switch (neighborhood) {
+    case Neighborhood::cardinal:
+        return reach_batch_body<Neighborhood::cardinal>(queries, results);
+    case Neighborhood::diagonal:
+        return reach_batch_body<Neighborhood::diagonal>(queries, results);
+    case Neighborhood::cardinal_and_diagonal:
+        return reach_batch_body<Neighborhood::cardinal_and_diagonal>(queries, results);
+    }
+}
+
+std::size_t serialize_moves_generic(const Move base, const Bits targets, std::span<Move> out) noexcept
+{
+    return serialize_moves_body(base, targets, out);
+}
+
+void evaluate_bit_planes_generic(
+    std::span<const Bits> planes, std::span<const BitBoard> boards, std::span<Score> scores
+) noexcept
+{
+    evaluate_bit_planes_body(planes, boards, scores, 0);
+}
+
+void row_neighbors_generic(
+    std::span<const Bits> words,
+    std::span<Bits> out,
+    const std::size_t n_rows,
+    const Bits row_mask,
+    const Neighborhood neighborhood
+) noexcept
+{
+    row_neighbors_body(words, out, n_rows, row_mask, neighborhood, 1);
+}
+
+template <int J>
+constexpr Bits transpose_mask = transpose_mask<J * 2> ^ (transpose_mask<J * 2> << J);
+template <>
+constexpr Bits transpose_mask<32> = 0x00000000'ffffffff;
+
+// Swaps the off-diagonal J x J blocks of every 2J x 2J block.
+template <int J>
+BITBOARD_INLINE void transpose_round(std::array<Bits, 64>& a) noexcept
+{
+    constexpr Bits m = transpose_mask<J>;
+    for (std::size_t k = 0; k < 64; k = ((k | J) + 1) & ~std::size_t{J}) {
+        const Bits t = (a[k] ^ (a[k | J] >> J)) & m;
+        a[k] ^= t;
+        a[k | J] ^= t << J;
+    }
+}
+
+void transpose_64x64_generic(std::span<const Bits, 64> in, std::span<Bits, 64> out) noexcept
+{
+    std::array<Bits, 64> a;
+    std::copy(in.begin(), in.end(), a.begin());
+    transpose_round<32>(a);
+    transpose_round<16>(a);
+    transpose_round<8>(a);
+    transpose_round<4>(a);
+    transpose_round<2>(a);
+    transpose_round<1>(a);
+    std::copy(a.begin(), a.end(), out.begin());
+}
+
+#if defined(BITBOARD_X86_KERNELS)
+
+BITBOARD_TARGET("popcnt") std::size_t count_total_popcnt(std::span<const BitBoard> boards) noexcept
+{
+    return count_total_body(boards);
+}
+
+BITBOARD_TARGET("popcnt") std::size_t count_words_popcnt(std::span<const Bits> words) noexcept
+{
+    return count_words_body(words);
+}
+
+BITBOARD_TARGET("popcnt") void count_each_popcnt(std::span<const BitBoard> boards, std::span<std::uint8_t> counts) noexcept
+{
+    count_each_body(boards, counts);
+}
+
+BITBOARD_TARGET("popcnt,lzcnt")
+std::size_t square_indices_popcnt(const BitBoard board, std::span<std::uint8_t, BitBoard::n_bits> indices) noexcept
+{
+    return square_indices_body(board, indices);
+}
+
+BITBOARD_TARGET("popcnt")
+std::size_t serialize_moves_popcnt(const Move base, const Bits targets, std::span<Move> out) noexcept
+{
+    return serialize_moves_body(base, targets, out);
+}
+
+BITBOARD_TARGET("popcnt")
+void evaluate_bit_planes_popcnt(
+    std::span<const Bits> planes, std::span<const BitBoard> boards, std::span<Score> scores
+) noexcept
+{
+    evaluate_bit_planes_body(planes, boards, scores, 0);
+}
+
+BITBOARD_TARGET("bmi2") Bits extract_bits_bmi2(const Bits bits, const Bits mask) noexcept
+{
+    return _pext_u64(bits, mask);
+}
+
+BITBOARD_TARGET("bmi2") Bits deposit_bits_bmi2(const Bits bits, const Bits mask) noexcept
+{
+    return _pdep_u64(bits, mask);
+}
+
+BITBOARD_TARGET("bmi2") Bits select_bit_bmi2(const Bits bits, const std::size_t n) noexcept
+{
+    return n < BitBoard::n_bits ? _pdep_u64(Bits{1} << n, bits) : 0;
+}
+
+BITBOARD_TARGET("popcnt,bmi")
+std::size_t serialize_moves_bmi2(const Move base, const Bits targets, std::span<Move> out) noexcept
+{
+    return serialize_moves_body(base, targets, out);
+}
+
+BITBOARD_TARGET("avx2") BITBOARD_INLINE __m256i popcount_epi64_avx2(const __m256i words) noexcept
+{
+    const __m256i nibble_counts = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    );
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0f);
+    const __m256i low = _mm256_and_si256(words, low_nibbles);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(words, 4), low_nibbles);
+    const __m256i byte_counts =
+        _mm256_add_epi8(_mm256_shuffle_epi8(nibble_counts, low), _mm256_shuffle_epi8(nibble_counts, high));
+    return _mm256_sad_epu8(byte_counts, _mm256_setzero_si256());
+}
+
+BITBOARD_TARGET("avx2,popcnt") std::size_t count_total_avx2(std::span<const BitBoard> boards) noexcept
+{
+    constexpr std::size_t boards_per_step = sizeof(__m256i) / sizeof(BitBoard);
+    __m256i sum = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + boards_per_step <= boards.size(); i += boards_per_step) {
+        const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boards.data() + i));
+        sum = _mm256_add_epi64(sum, popcount_epi64_avx2(words));
+    }
+    alignas(sizeof(__m256i)) std::array<std::uint64_t, boards_per_step> lanes{};
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.data()), sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + count_total_body(boards.subspan(i));
+}
+
+BITBOARD_TARGET("avx2,popcnt")
+void evaluate_bit_planes_avx2(
+    std::span<const Bits> planes, std::span<const BitBoard> boards, std::span<Score> scores
+) noexcept
+{
+    constexpr std::size_t boards_per_step = sizeof(__m256i) / sizeof(BitBoard);
+    const auto sign_plane = planes.size() - 1;
+    const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+
+    std::size_t i = 0;
+    for (; i + boards_per_step <= boards.size(); i += boards_per_step) {
+        const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boards.data() + i));
+        __m256i sum = _mm256_setzero_si256();
+        for (std::size_t plane = 0; plane < sign_plane; ++plane) {
+            const auto plane_words = _mm256_set1_epi64x(static_cast<long long>(planes[plane]));
+            const auto counts = popcount_epi64_avx2(_mm256_and_si256(words, plane_words));
+            sum = _mm256_add_epi64(sum, _mm256_sll_epi64(counts, _mm_cvtsi64_si128(plane)));
+        }
+        const auto sign_words = _mm256_set1_epi64x(static_cast<long long>(planes[sign_plane]));
+        const auto sign_counts = popcount_epi64_avx2(_mm256_and_si256(words, sign_words));
+        sum = _mm256_sub_epi64(sum, _mm256_sll_epi64(sign_counts, _mm_cvtsi64_si128(sign_plane)));
+
+        const __m256i packed = _mm256_permutevar8x32_epi32(sum, low_halves);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(scores.data() + i), _mm256_castsi256_si128(packed));
+    }
+    evaluate_bit_planes_body(planes, boards, scores, i);
+}
+
+BITBOARD_TARGET("avx2")
+void row_neighbors_avx2(
+    std::span<const Bits> words,
+    std::span<Bits> out,
+    const std::size_t n_rows,
+    const Bits row_mask,
+    const Neighborhood neighborhood
+) noexcept
+{
+    constexpr std::size_t rows_per_step = sizeof(__m256i) / sizeof(Bits);
+    assert(n_rows + 2 <= words.size() && words.size() == out.size());
+    const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(row_mask));
+    const bool cardinal = neighborhood != Neighborhood::diagonal;
+    const bool diagonal = neighborhood != Neighborhood::cardinal;
+
+    std::size_t row = 1;
+    for (; row + rows_per_step <= n_rows + 1; row += rows_per_step) {
+        const auto* const source = reinterpret_cast<const __m256i*>(words.data() + row);
+        const __m256i vertical = _mm256_or_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words.data() + row - 1)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words.data() + row + 1))
+        );
+        __m256i result = _mm256_setzero_si256();
+        if (cardinal) {
+            const __m256i center = _mm256_loadu_si256(source);
+            result = _mm256_or_si256(
+                _mm256_or_si256(_mm256_slli_epi64(center, 1), _mm256_srli_epi64(center, 1)), vertical
+            );
+        }
+        if (diagonal) {
+            result = _mm256_or_si256(
+                result, _mm256_or_si256(_mm256_slli_epi64(vertical, 1), _mm256_srli_epi64(vertical, 1))
+            );
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data() + row), _mm256_and_si256(result, mask));
+    }
+    row_neighbors_body(words, out, n_rows, row_mask, neighborhood, row);
+}
+
+// Squares one step from each lane's frontier. Columns are bits within a row byte, so horizontal moves need
+// masks against wrapping into the neighboring row.
+template <Neighborhood N>
+BITBOARD_TARGET("avx2") BITBOARD_INLINE __m256i step_avx2(const __m256i frontier) noexcept
+{
+    const __m256i not_right_edge = _mm256_set1_epi64x(static_cast<long long>(~Bits{0x0101010101010101}));
+    const __m256i not_left_edge = _mm256_set1_epi64x(static_cast<long long>(~Bits{0x8080808080808080}));
+    const __m256i horizontal = _mm256_or_si256(
+        _mm256_and_si256(_mm256_slli_epi64(frontier, 1), not_right_edge),
+        _mm256_and_si256(_mm256_srli_epi64(frontier, 1), not_left_edge)
+    );
+    __m256i rows = _mm256_setzero_si256();
+    __m256i result = _mm256_setzero_si256();
+    if constexpr (N != Neighborhood::diagonal) {
+        rows = frontier;
+        result = horizontal;
+    }
+    if constexpr (N != Neighborhood::cardinal) {
+        rows = _mm256_or_si256(rows, horizontal);
+    }
+    return _mm256_or_si256(result, _mm256_or_si256(_mm256_slli_epi64(rows, 8), _mm256_srli_epi64(rows, 8)));
+}
+
+// Four queries, one per 64-bit lane. A lane drops out of active once it hits a target, finds nothing new or uses
+// up its steps; masking its frontier then freezes reached and steps.
+struct ReachLanesAvx2
+{
+    __m256i allowed;
+    __m256i targets;
+    __m256i limit;
+    __m256i reached;
+    __m256i frontier;
+    __m256i steps;
+    __m256i active;
+};
+
+BITBOARD_TARGET("avx2") BITBOARD_INLINE ReachLanesAvx2 load_reach_lanes_avx2(const ReachQuery* const q) noexcept
+{
+    const auto lane = [](const BitBoard board) { return static_cast<long long>(board.to_ullong()); };
+    // No path is longer than the board, so clamping keeps step counts inside a signed lane.
+    const auto max_steps = [](const ReachQuery& query) {
+        return static_cast<long long>(std::min(query.max_steps, BitBoard::n_bits));
+    };
+    const __m256i zero = _mm256_setzero_si256();
+    ReachLanesAvx2 lanes;
+    lanes.allowed = _mm256_setr_epi64x(lane(q[0].allowed), lane(q[1].allowed), lane(q[2].allowed), lane(q[3].allowed));
+    lanes.targets = _mm256_setr_epi64x(lane(q[0].targets), lane(q[1].targets), lane(q[2].targets), lane(q[3].targets));
+    lanes.limit = _mm256_setr_epi64x(max_steps(q[0]), max_steps(q[1]), max_steps(q[2]), max_steps(q[3]));
+    lanes.reached = _mm256_setr_epi64x(lane(q[0].sources), lane(q[1].sources), lane(q[2].sources), lane(q[3].sources));
+    lanes.frontier = lanes.reached;
+    lanes.steps = zero;
+    lanes.active = _mm256_andnot_si256(
+        _mm256_cmpeq_epi64(lanes.limit, zero), _mm256_cmpeq_epi64(_mm256_and_si256(lanes.reached, lanes.targets), zero)
+    );
+    return lanes;
+}
+
+template <Neighborhood N>
+BITBOARD_TARGET("avx2") BITBOARD_INLINE void advance_reach_lanes_avx2(ReachLanesAvx2& lanes) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i next_ring = _mm256_and_si256(step_avx2<N>(lanes.frontier), lanes.allowed);
+    lanes.frontier = _mm256_and_si256(_mm256_andnot_si256(lanes.reached, next_ring), lanes.active);
+    lanes.reached = _mm256_or_si256(lanes.reached, lanes.frontier);
+    const __m256i empty = _mm256_cmpeq_epi64(lanes.frontier, zero);
+    lanes.steps = _mm256_sub_epi64(lanes.steps, _mm256_xor_si256(empty, _mm256_cmpeq_epi64(zero, zero)));
+    const __m256i missed = _mm256_cmpeq_epi64(_mm256_and_si256(lanes.frontier, lanes.targets), zero);
+    const __m256i exhausted = _mm256_cmpeq_epi64(lanes.steps, lanes.limit);
+    lanes.active = _mm256_and_si256(lanes.active, _mm256_andnot_si256(_mm256_or_si256(empty, exhausted), missed));
+}
+
+BITBOARD_TARGET("avx2")
+BITBOARD_INLINE void store_reach_lanes_avx2(
+    const ReachLanesAvx2& lanes, const ReachQuery* const queries, ReachResult* const results
+) noexcept
+{
+    constexpr std::size_t n_lanes = sizeof(__m256i) / sizeof(Bits);
+    alignas(32) Bits reached[n_lanes];
+    alignas(32) Bits steps[n_lanes];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(reached), lanes.reached);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(steps), lanes.steps);
+    for (std::size_t j = 0; j < n_lanes; ++j) {
+        const BitBoard lane_reached{reached[j]};
+        results[j] = ReachResult{lane_reached, steps[j], lane_reached.test_any(queries[j].targets)};
+    }
+}
+
+// Eight queries per group in two vectors stepped in the same loop, so that their dependency chains overlap. The
+// group ends when no lane of either is active.
+template <Neighborhood N>
+BITBOARD_TARGET("avx2")
+BITBOARD_INLINE void reach_batch_body_avx2(std::span<const ReachQuery> queries, std::span<ReachResult> results) noexcept
+{
+    constexpr std::size_t lanes = sizeof(__m256i) / sizeof(Bits);
+    std::size_t i = 0;
+    for (; i + 2 * lanes <= queries.size(); i += 2 * lanes) {
+        auto first = load_reach_lanes_avx2(queries.data() + i);
+        auto second = load_reach_lanes_avx2(queries.data() + i + lanes);
+        while (_mm256_movemask_epi8(_mm256_or_si256(first.active, second.active)) != 0) {
+            advance_reach_lanes_avx2<N>(first);
+            advance_reach_lanes_avx2<N>(second);
+        }
+        store_reach_lanes_avx2(first, queries.data() + i, results.data() + i);
+        store_reach_lanes_avx2(second, queries.data() + i + lanes, results.data() + i + lanes);
+    }
+    reach_batch_body<N>(queries.subspan(i), results.subspan(i));
+}
+
+BITBOARD_TARGET("avx2")
+void reach_batch_avx2(
+    std::span<const ReachQuery> queries, std::span<ReachResult> results, const Neighborhood neighborhood
+) noexcept
+{
+    assert(results.size() >= queries.size());
+    switch (neighborhood) {
+    case Neighborhood::cardinal:
+        return reach_batch_body_avx2<Neighborhood::cardinal>(queries, results);
+    case Neighborhood::diagonal:
+        return reach_batch_body_avx2<Neighborhood::diagonal>(queries, results);
+    case Neighborhood::cardinal_and_diagonal:
+        return reach_batch_body_avx2<Neighborhood::cardinal_and_diagonal>(queries, results);
+    }
+}
+
+// Rounds with J >= 4 pair whole vectors of four rows; J = 2 and J = 1 pair lanes within a vector.
+template <int J>
+BITBOARD_TARGET("avx2") BITBOARD_INLINE void transpose_round_avx2(__m256i (&v)[16]) noexcept
+{
+    const __m256i m = _mm256_set1_epi64x(static_cast<long long>(transpose_mask<J>));
+    if constexpr (J >= 4) {
+        constexpr std::size_t jv = J / 4;
+        for (std::size_t q = 0; q < std::size(v); q = ((q | jv) + 1) & ~jv) {
+            const __m256i t = _mm256_and_si256(_mm256_xor_si256(v[q], _mm256_srli_epi64(v[q | jv], J)), m);
+            v[q] = _mm256_xor_si256(v[q], t);
+            v[q | jv] = _mm256_xor_si256(v[q | jv], _mm256_slli_epi64(t, J));
+        }
+    } else {
+        constexpr int swap = J == 2 ? 0x4e : 0xb1;
+        const __m256i low_lanes = J == 2 ? _mm256_setr_epi64x(-1, -1, 0, 0) : _mm256_setr_epi64x(-1, 0, -1, 0);
+        for (auto& x : v) {
+            const __m256i partner = _mm256_permute4x64_epi64(x, swap);
+            const __m256i t =
+                _mm256_and_si256(_mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(partner, J)), m), low_lanes);
+            x = _mm256_xor_si256(x, _mm256_xor_si256(t, _mm256_permute4x64_epi64(_mm256_slli_epi64(t, J), swap)));
+        }
+    }
+}
+
+BITBOARD_TARGET("avx2") void transpose_64x64_avx2(std::span<const Bits, 64> in, std::span<Bits, 64> out) noexcept
+{
+    __m256i v[16];
+    for (std::size_t q = 0; q < std::size(v); ++q) {
+        v[q] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.data() + 4 * q));
+    }
+    transpose_round_avx2<32>(v);
+    transpose_round_avx2<16>(v);
+    transpose_round_avx2<8>(v);
+    transpose_round_avx2<4>(v);
+    transpose_round_avx2<2>(v);
+    transpose_round_avx2<1>(v);
+    for (std::size_t q = 0; q < std::size(v); ++q) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data() + 4 * q), v[q]);
+    }
+}
+
+BITBOARD_TARGET("avx512f,avx512vpopcntdq,popcnt")
+std::size_t count_total_avx512(std::span<const BitBoard> boards) noexcept
+{
+    constexpr std::size_t boards_per_step = sizeof(__m512i) / sizeof(BitBoard);
+    __m512i sum = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + boards_per_step <= boards.size(); i += boards_per_step) {
+        const __m512i words = _mm512_loadu_si512(boards.data() + i);
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(words));
+    }
+    return static_cast<std::size_t>(_mm512_reduce_add_epi64(sum)) + count_total_body(boards.subspan(i));
+}
+
+BITBOARD_TARGET("avx512f,avx512vpopcntdq,popcnt")
+void count_each_avx512(std::span<const BitBoard> boards, std::span<std::uint8_t> counts) noexcept
+{
+    constexpr std::size_t boards_per_step = sizeof(__m512i) / sizeof(BitBoard);
+    std::size_t i = 0;
+    for (; i + boards_per_step <= boards.size(); i += boards_per_step) {
+        const __m512i words = _mm512_loadu_si512(boards.data() + i);
+        const __m128i packed = _mm512_cvtepi64_epi8(_mm512_popcnt_epi64(words));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(counts.data() + i), packed);
+    }
+    count_each_body(boards.subspan(i), counts.subspan(i));
+}
+
+BITBOARD_TARGET("avx512f,avx512vpopcntdq,popcnt")
+void evaluate_bit_planes_avx512(
+    std::span<const Bits> planes, std::span<const BitBoard> boards, std::span<Score> scores
+) noexcept
+{
+    constexpr std::size_t boards_per_step = sizeof(__m512i) / sizeof(BitBoard);
+    const auto sign_plane = planes.size() - 1;
+
+    std::size_t i = 0;
+    for (; i + boards_per_step <= boards.size(); i += boards_per_step) {
+        const __m512i words = _mm512_loadu_si512(boards.data() + i);
+        __m512i sum = _mm512_setzero_si512();
+        for (std::size_t plane = 0; plane < sign_plane; ++plane) {
+            const auto plane_words = _mm512_set1_epi64(static_cast<long long>(planes[plane]));
+            const auto counts = _mm512_popcnt_epi64(_mm512_and_si512(words, plane_words));
+            sum = _mm512_add_epi64(sum, _mm512_sll_epi64(counts, _mm_cvtsi64_si128(plane)));
+        }
+        const auto sign_words = _mm512_set1_epi64(static_cast<long long>(planes[sign_plane]));
+        const auto sign_counts = _mm512_popcnt_epi64(_mm512_and_si512(words, sign_words));
+        sum = _mm512_sub_epi64(sum, _mm512_sll_epi64(sign_counts, _mm_cvtsi64_si128(sign_plane)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores.data() + i), _mm512_cvtepi64_epi32(sum));
+    }
+    evaluate_bit_planes_body(planes, boards, scores, i);
+}
+
+// Sixteen target bits at a time: lane j holds the move to bit 16 * chunk + j, VPCOMPRESSD packs the lanes whose
+// bit is set and VPMOVDW narrows them to 16-bit moves on the way to memory.
+BITBOARD_TARGET("avx512f,popcnt")
+std::size_t serialize_moves_avx512(const Move base, const Bits targets, std::span<Move> out) noexcept
+{
+    constexpr std::size_t lanes = 16;
+    assert(static_cast<std::size_t>(std::popcount(targets)) <= out.size());
+    const __m512i lane_offsets = _mm512_slli_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), Move::square_bits
+    );
+    std::size_t n = 0;
+    for (std::size_t chunk = 0; chunk < BitBoard::n_bits / lanes; ++chunk) {
+        const auto mask = static_cast<__mmask16>(targets >> (lanes * chunk));
+        if (mask == 0) {
+            continue;
+        }
+        const auto first_to = BitBoard::n_bits - 1 - lanes * chunk;
+        const __m512i moves = _mm512_sub_epi32(
+            _mm512_set1_epi32(static_cast<int>(base.bits() | (first_to << Move::square_bits))), lane_offsets
+        );
+        const auto count = static_cast<std::size_t>(std::popcount(static_cast<unsigned>(mask)));
+        const auto store_mask = static_cast<__mmask16>((1U << count) - 1);
+        _mm512_mask_cvtepi32_storeu_epi16(out.data() + n, store_mask, _mm512_maskz_compress_epi32(mask, moves));
+        n += count;
+    }
+    return n;
+}
+
+// Exchanges 64-bit lane l with lane l ^ J.
+template <int J>
+BITBOARD_TARGET("avx512f") BITBOARD_INLINE __m512i swap_lanes_avx512(const __m512i x) noexcept
+{
+    if constexpr (J == 4) {
+        return _mm512_shuffle_i64x2(x, x, 0x4e);
+    } else if constexpr (J == 2) {
+        return _mm512_shuffle_i64x2(x, x, 0xb1);
+    } else {
+        return _mm512_shuffle_epi32(x, _MM_PERM_BADC);
+    }
+}
+
+template <int J>
+BITBOARD_TARGET("avx512f") BITBOARD_INLINE void transpose_round_avx512(__m512i (&v)[8]) noexcept
+{
+    const __m512i m = _mm512_set1_epi64(static_cast<long long>(transpose_mask<J>));
+    if constexpr (J >= 8) {
+        constexpr std::size_t jv = J / 8;
+        for (std::size_t q = 0; q < std::size(v); q = ((q | jv) + 1) & ~jv) {
+            const __m512i t = _mm512_and_si512(_mm512_xor_si512(v[q], _mm512_srli_epi64(v[q | jv], J)), m);
+            v[q] = _mm512_xor_si512(v[q], t);
+            v[q | jv] = _mm512_xor_si512(v[q | jv], _mm512_slli_epi64(t, J));
+        }
+    } else {
+        constexpr __mmask8 low_lanes = J == 4 ? 0x0f : J == 2 ? 0x33 : 0x55;
+        for (auto& x : v) {
+            const __m512i partner = swap_lanes_avx512<J>(x);
+            const __m512i t = _mm512_maskz_and_epi64(low_lanes, _mm512_xor_si512(x, _mm512_srli_epi64(partner, J)), m);
+            x = _mm512_xor_si512(x, _mm512_xor_si512(t, swap_lanes_avx512<J>(_mm512_slli_epi64(t, J))));
+        }
+    }
+}
+
+BITBOARD_TARGET("avx512f") void transpose_64x64_avx512(std::span<const Bits, 64> in, std::span<Bits, 64> out) noexcept
+{
+    __m512i v[8];
+    for (std::size_t q = 0; q < std::size(v); ++q) {
+        v[q] = _mm512_loadu_si512(in.data() + 8 * q);
+    }
+    transpose_round_avx512<32>(v);
+    transpose_round_avx512<16>(v);
+    transpose_round_avx512<8>(v);
+    transpose_round_avx512<4>(v);
+    transpose_round_avx512<2>(v);
+    transpose_round_avx512<1>(v);
+    for (std::size_t q = 0; q < std::size(v); ++q) {
+        _mm512_storeu_si512(out.data() + 8 * q, v[q]);
+    }
+}
+
+#endif
+
+constexpr Kernels generic_kernels{
+    CpuLevel::generic,
+    &count_total_generic,
+    &count_words_generic,
+    &count_each_generic,
+    &square_indices_generic,
+    &extract_bits_generic,
+    &deposit_bits_generic,
+    &select_bit_generic,
+    &serialize_moves_generic,
+    &evaluate_bit_planes_generic,
+    &transpose_64x64_generic,
+    &row_neighbors_generic,
+    &reach_batch_generic,
+};
+
+#if defined(BITBOARD_X86_KERNELS)
+constexpr Kernels popcnt_kernels{
+    CpuLevel::popcnt,
+    &count_total_popcnt,
+    &count_words_popcnt,
+    &count_each_popcnt,
+    &square_indices_popcnt,
+    &extract_bits_generic,
+    &deposit_bits_generic,
+    &select_bit_generic,
+    &serialize_moves_popcnt,
+    &evaluate_bit_planes_popcnt,
+    &transpose_64x64_generic,
+    &row_neighbors_generic,
+    &reach_batch_generic,
+};
+
+constexpr Kernels bmi2_kernels{
+    CpuLevel::bmi2,
+    &count_total_popcnt,
+    &count_words_popcnt,
+    &count_each_popcnt,
+    &square_indices_popcnt,
+    &extract_bits_bmi2,
+    &deposit_bits_bmi2,
+    &select_bit_bmi2,
+    &serialize_moves_bmi2,
+    &evaluate_bit_planes_popcnt,
+    &transpose_64x64_generic,
+    &row_neighbors_generic,
+    &reach_batch_generic,
+};
+
+constexpr Kernels avx2_kernels{
+    CpuLevel::avx2,
+    &count_total_avx2,
+    &count_words_popcnt,
+    &count_each_popcnt,
+    &square_indices_popcnt,
+    &extract_bits_bmi2,
+    &deposit_bits_bmi2,
+    &select_bit_bmi2,
+    &serialize_moves_bmi2,
+    &evaluate_bit_planes_avx2,
+    &transpose_64x64_avx2,
+    &row_neighbors_avx2,
+    &reach_batch_avx2,
+};
+
+constexpr Kernels avx512_kernels{
+    CpuLevel::avx512,
+    &count_total_avx512,
+    &count_words_popcnt,
+    &count_each_avx512,
+    &square_indices_popcnt,
+    &extract_bits_bmi2,
+    &deposit_bits_bmi2,
+    &select_bit_bmi2,
+    &serialize_moves_avx512,
+    &evaluate_bit_planes_avx512,
+    &transpose_64x64_avx512,
+    &row_neighbors_avx2,
+    &reach_batch_avx2,
+};
+#endif
+
+std::atomic<const Kernels*>& active_kernels() noexcept
+{
+    static std::atomic<const Kernels*> active{&kernels_for(cpu_level())};
+    return active;
+}
+
+} // namespace
+
+const Kernels& kernels() noexcept
+{
+    return *active_kernels().load(std::memory_order_relaxed);
+}
+
+const Kernels& kernels_for([[maybe_unused]] const CpuLevel level) noexcept
+{
+#if defined(BITBOARD_X86_KERNELS)
+    switch (level) {
+    case CpuLevel::generic:
+        return generic_kernels;
+    case CpuLevel::popcnt:
+        return popcnt_kernels;
+    case CpuLevel::bmi2:
+        return bmi2_kernels;
+    case CpuLevel::avx2:
+        return avx2_kernels;
+    case CpuLevel::avx512:
+        return avx512_kernels;
+    }
+    assert(!"invalid cpu level");
+#endif
+    return generic_kernels;
+}
+
+void select_kernels(const CpuLevel level) noexcept
+{
+    active_kernels().store(&kernels_for(level), std::memory_order_relaxed);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "evaluation.h"
+#include "move_list.h"
+
+#include <cstdint>
+
+#include <span>
+
+enum class Neighborhood
+{
+    cardinal,
+    diagonal,
+    cardinal_and_diagonal,
+};
+
+struct ReachQuery;
+struct ReachResult;
+
+struct Kernels
+{
+    using Bits = BitBoard::Bits;
+
+    CpuLevel level;
+    std::size_t (*count_total)(std::span<const BitBoard> boards) noexcept;
+    std::size_t (*count_words)(std::span<const Bits> words) noexcept;
+    void (*count_each)(std::span<const BitBoard> boards, std::span<std::uint8_t> counts) noexcept;
+    std::size_t (*square_indices)(BitBoard board, std::span<std::uint8_t, BitBoard::n_bits> indices) noexcept;
+    Bits (*extract_bits)(Bits bits, Bits mask) noexcept;
+    Bits (*deposit_bits)(Bits bits, Bits mask) noexcept;
+    // The n-th set bit counting from the least significant (n = 0), or 0 if bits has n or fewer set bits.
+    Bits (*select_bit)(Bits bits, std::size_t n) noexcept;
+    // One move per set bit of targets, least significant first, each base with the target's square as to.
+    std::size_t (*serialize_moves)(Move base, Bits targets, std::span<Move> out) noexcept;
+    void (*evaluate_bit_planes)(
+        std::span<const Bits> planes, std::span<const BitBoard> boards, std::span<Score> scores
+    ) noexcept;
+    // Transposes a 64x64 bit matrix whose rows are words and whose column c is bit (63 - c); in may alias out.
+    void (*transpose_64x64)(std::span<const Bits, 64> in, std::span<Bits, 64> out) noexcept;
+    // Row-major boards with one word per row; words [0] and [n_rows + 1] are zero guard rows. There is no 8-lane
+    // version: the avx512 level uses the AVX2 kernel.
+    void (*row_neighbors)(
+        std::span<const Bits> words, std::span<Bits> out, std::size_t n_rows, Bits row_mask, Neighborhood neighborhood
+    ) noexcept;
+    // results.size() >= queries.size(); see reach_batch() in reachability.h. The avx512 level also uses the AVX2
+    // kernel here.
+    void (*reach_batch)(
+        std::span<const ReachQuery> queries, std::span<ReachResult> results, Neighborhood neighborhood
+    ) noexcept;
+};
+
+[[nodiscard]] const Kernels& kernels() noexcept;
+
+[[nodiscard]] const Kernels& kernels_for(CpuLevel level) noexcept;
+
+void select_kernels(CpuLevel level) noexcept;
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <array>
+#include <span>
+
+// Attacks of every piece on a board at once. A leaper jumps straight to the squares dx rows and dy columns away,
+// in all eight combinations of signs and order, so its attacks are an OR of shifted copies of the whole board.
+
+// All squares attacked by (DX, DY) leapers standing on the squares of pieces. Each of the eight offsets is a
+// compile-time Offset, i.e. one shift and one constant mask.
+template <int DX, int DY>
+[[nodiscard]] constexpr BitBoard leaper_attacks(const BitBoard pieces) noexcept
+{
+    return BitBoard::shift(pieces, Offset<DX, DY>{}) | BitBoard::shift(pieces, Offset<DX, -DY>{}) |
+           BitBoard::shift(pieces, Offset<-DX, DY>{}) | BitBoard::shift(pieces, Offset<-DX, -DY>{}) |
+           BitBoard::shift(pieces, Offset<DY, DX>{}) | BitBoard::shift(pieces, Offset<DY, -DX>{}) |
+           BitBoard::shift(pieces, Offset<-DY, DX>{}) | BitBoard::shift(pieces, Offset<-DY, -DX>{});
+}
+
+[[nodiscard]] constexpr BitBoard knight_attacks(const BitBoard pieces) noexcept
+{
+    return leaper_attacks<1, 2>(pieces);
+}
+
+[[nodiscard]] constexpr BitBoard camel_attacks(const BitBoard pieces) noexcept
+{
+    return leaper_attacks<1, 3>(pieces);
+}
+
+[[nodiscard]] constexpr BitBoard zebra_attacks(const BitBoard pieces) noexcept
+{
+    return leaper_attacks<2, 3>(pieces);
+}
+
+// A relative offset known only at run time, reduced once to the shift and mask that shift(board, Offset) uses.
+class LeaperStep
+{
+  public:
+    using Position = BitBoard::Position;
+    using Bits = BitBoard::Bits;
+
+    constexpr explicit LeaperStep(const Position& offset) noexcept
+        : mask_(offset_mask(offset)), amount_(mask_ == 0 ? 0 : offset.x() * BitBoard::board_size + offset.y())
+    {}
+
+    [[nodiscard]] constexpr BitBoard apply(const BitBoard pieces) const noexcept
+    {
+        const auto bits = static_cast<Bits>(pieces.to_ullong());
+        return BitBoard{(amount_ >= 0 ? bits >> amount_ : bits << -amount_) & mask_};
+    }
+
+  private:
+    Bits mask_;
+    int amount_;
+
+    // Columns a square can land in without wrapping, or nothing if the offset leaves the board entirely.
+    static constexpr Bits offset_mask(const Position& offset) noexcept
+    {
+        constexpr Bits every_row = 0x0101010101010101;
+        constexpr unsigned full_row = 0xff;
+        const int dx = offset.x();
+        const int dy = offset.y();
+        if (dx <= -BitBoard::board_size || dx >= BitBoard::board_size || dy <= -BitBoard::board_size ||
+            dy >= BitBoard::board_size) {
+            return 0;
+        }
+        // Column 0 is the most significant bit of each row byte.
+        const unsigned row = dy >= 0 ? full_row >> dy : (full_row << -dy) & full_row;
+        return row * every_row;
+    }
+};
+
+// The eight LeaperSteps of a (dx, dy) leaper; symmetric leapers such as (0, 1) repeat some of them.
+[[nodiscard]] constexpr std::array<LeaperStep, 8> leaper_steps(const int dx, const int dy) noexcept
+{
+    using Position = BitBoard::Position;
+    return {
+        LeaperStep{Position{dx, dy}},
+        LeaperStep{Position{dx, -dy}},
+        LeaperStep{Position{-dx, dy}},
+        LeaperStep{Position{-dx, -dy}},
+        LeaperStep{Position{dy, dx}},
+        LeaperStep{Position{dy, -dx}},
+        LeaperStep{Position{-dy, dx}},
+        LeaperStep{Position{-dy, -dx}},
+    };
+}
+
+// All squares reached from pieces by any of the steps. Steps are built once, so each one costs a shift and a mask.
+[[nodiscard]] constexpr BitBoard leaper_attacks(const BitBoard pieces, const std::span<const LeaperStep> steps) noexcept
+{
+    BitBoard attacks{};
+    for (const auto& step : steps) {
+        attacks |= step.apply(pieces);
+    }
+    return attacks;
+}
+
+[[nodiscard]] constexpr BitBoard leaper_attacks(const BitBoard pieces, const int dx, const int dy) noexcept
+{
+    const auto steps = leaper_steps(dx, dy);
+    return leaper_attacks(pieces, steps);
+}
+
+// Pawns advance one row towards Forward (up or down) and capture one column to either side of the square ahead.
+template <Direction Forward>
+[[nodiscard]] constexpr BitBoard pawn_pushes(const BitBoard pawns, const BitBoard empty) noexcept
+{
+    static_assert(Forward == Direction::up || Forward == Direction::down, "pawns move up or down");
+    return BitBoard::shift<Forward, 1>(pawns) & empty;
+}
+
+// Targets of the two-row first move from the second row of the pawns' own side; the square passed over and the
+// target must both be empty.
+template <Direction Forward>
+[[nodiscard]] constexpr BitBoard pawn_double_pushes(const BitBoard pawns, const BitBoard empty) noexcept
+{
+    static_assert(Forward == Direction::up || Forward == Direction::down, "pawns move up or down");
+    constexpr auto start_row = Forward == Direction::up ? BitBoard::make_row<BitBoard::board_size - 2>()
+                                                        : BitBoard::make_row<1>();
+    return pawn_pushes<Forward>(pawn_pushes<Forward>(pawns & start_row, empty), empty);
+}
+
+template <Direction Forward>
+[[nodiscard]] constexpr BitBoard pawn_attacks(const BitBoard pawns) noexcept
+{
+    static_assert(Forward == Direction::up || Forward == Direction::down, "pawns move up or down");
+    if constexpr (Forward == Direction::up) {
+        return BitBoard::shift<Direction::upleft, 1>(pawns) | BitBoard::shift<Direction::upright, 1>(pawns);
+    } else {
+        return BitBoard::shift<Direction::downleft, 1>(pawns) | BitBoard::shift<Direction::downright, 1>(pawns);
+    }
+}
+
+template <Direction Forward>
+[[nodiscard]] constexpr BitBoard pawn_captures(const BitBoard pawns, const BitBoard targets) noexcept
+{
+    return pawn_attacks<Forward>(pawns) & targets;
+}
@@ -0,0 +1,13 @@
+#include "move_list.h"
+
+#include "bit_board.h"
+#include "kernels.h"
+
+#include <cstddef>
+
+#include <span>
+
+std::size_t serialize_moves(const Move base, const BitBoard targets, std::span<Move> out) noexcept
+{
+    return kernels().serialize_moves(base, targets.to_ullong(), out);
+}
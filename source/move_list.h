@@ -0,0 +1,138 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <span>
+#include <stdexcept>
+
+// A move packed into 16 bits: from square in bits 0-5, to square in bits 6-11 and caller-defined flags in bits
+// 12-15. Squares are indices x * 8 + y, as in BitBoard.
+class Move
+{
+  public:
+    using Position = BitBoard::Position;
+
+    static constexpr unsigned square_bits = 6;
+
+    // Left uninitialized so that a MoveList's storage costs nothing to construct.
+    constexpr Move() noexcept = default;
+    constexpr explicit Move(const std::uint16_t bits) noexcept : bits_(bits) {}
+    constexpr explicit Move(const std::size_t from, const std::size_t to, const unsigned flags = 0) noexcept
+        : bits_(static_cast<std::uint16_t>(from | (to << square_bits) | (flags << (2 * square_bits))))
+    {}
+
+    [[nodiscard]] constexpr std::size_t from() const noexcept
+    {
+        return bits_ & square_mask;
+    }
+    [[nodiscard]] constexpr std::size_t to() const noexcept
+    {
+        return (bits_ >> square_bits) & square_mask;
+    }
+    [[nodiscard]] constexpr unsigned flags() const noexcept
+    {
+        return bits_ >> (2 * square_bits);
+    }
+    [[nodiscard]] constexpr std::uint16_t bits() const noexcept
+    {
+        return bits_;
+    }
+
+    [[nodiscard]] constexpr Position from_position() const noexcept
+    {
+        return square_position(from());
+    }
+    [[nodiscard]] constexpr Position to_position() const noexcept
+    {
+        return square_position(to());
+    }
+
+    [[nodiscard]] constexpr friend bool operator==(const Move lhs, const Move rhs) noexcept = default;
+
+  private:
+    static constexpr std::uint16_t square_mask = (1U << square_bits) - 1;
+
+    std::uint16_t bits_;
+
+    static constexpr Position square_position(const std::size_t square) noexcept
+    {
+        using T = Position::dimension_type;
+        return {static_cast<T>(square / BitBoard::board_size), static_cast<T>(square % BitBoard::board_size)};
+    }
+};
+
+static_assert(sizeof(Move) == sizeof(std::uint16_t), "moves are stored packed");
+
+// Writes one move from base.from() with base.flags() to every square of targets, least significant bit (bottom
+// right) first, and returns how many were written. base.to() must be 0 and out must have room for every move.
+// Uses the active kernels: unrolled tzcnt/blsr loops, or VPCOMPRESSD on AVX-512.
+std::size_t serialize_moves(Move base, BitBoard targets, std::span<Move> out) noexcept;
+
+// Fixed-capacity move buffer that lives on the stack. The storage is cache-line aligned and never initialized,
+// so move generation neither allocates nor touches memory it does not write.
+template <std::size_t Capacity = 256>
+class alignas(64) MoveList
+{
+  public:
+    using value_type = Move;
+    using const_iterator = const Move*;
+
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    void push_back(const Move move)
+    {
+        if (size_ == Capacity) {
+            throw std::length_error("move list is full");
+        }
+        moves_[size_++] = move;
+    }
+
+    // Appends a move from from to each square of targets.
+    void add_moves(const std::size_t from, const BitBoard targets, const unsigned flags = 0)
+    {
+        if (targets.count() > Capacity - size_) {
+            throw std::length_error("move list is full");
+        }
+        size_ += serialize_moves(Move{from, 0, flags}, targets, std::span{moves_}.subspan(size_));
+    }
+
+    [[nodiscard]] Move operator[](const std::size_t i) const noexcept
+    {
+        return moves_[i];
+    }
+    [[nodiscard]] const Move* data() const noexcept
+    {
+        return moves_.data();
+    }
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+        return moves_.data();
+    }
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+        return moves_.data() + size_;
+    }
+
+  private:
+    std::array<Move, Capacity> moves_;
+    std::size_t size_{0};
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+
+#include <array>
+
+// Per-square counts stored bit-sliced: bit i of a square's count is that square in plane i.
+template <std::size_t N>
+using CountPlanes = std::array<BitBoard, N>;
+
+// Adds one to the count of every square set in board.
+template <std::size_t N>
+[[nodiscard]] constexpr CountPlanes<N> add_board(CountPlanes<N> counts, BitBoard board) noexcept
+{
+    for (auto& plane : counts) {
+        const auto sum = plane ^ board;
+        board &= plane;
+        plane = sum;
+    }
+    return counts;
+}
+
+template <std::size_t N>
+[[nodiscard]] constexpr CountPlanes<N> add_counts(CountPlanes<N> counts, const CountPlanes<N>& addend) noexcept
+{
+    BitBoard carry{};
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto sum = counts[i] ^ addend[i] ^ carry;
+        carry = (counts[i] & addend[i]) | (carry & (counts[i] ^ addend[i]));
+        counts[i] = sum;
+    }
+    return counts;
+}
+
+template <Direction D, std::size_t Amount, std::size_t N>
+[[nodiscard]] constexpr CountPlanes<N> shift_counts(CountPlanes<N> counts) noexcept
+{
+    for (auto& plane : counts) {
+        plane = BitBoard::shift<D, Amount>(plane);
+    }
+    return counts;
+}
+
+// Number of set squares among the eight neighbors of each square (0 to 8). The eight shifted boards are summed
+// with a carry-save adder tree, so all 64 squares are counted in a few dozen word operations.
+[[nodiscard]] constexpr CountPlanes<4> neighbor_counts(const BitBoard board) noexcept
+{
+    const auto full_add = [](const BitBoard a, const BitBoard b, const BitBoard c) {
+        return std::array{a ^ b ^ c, (a & b) | (c & (a ^ b))};
+    };
+    const auto [s0, c0] = full_add(
+        BitBoard::shift<Direction::up>(board),
+        BitBoard::shift<Direction::down>(board),
+        BitBoard::shift<Direction::left>(board)
+    );
+    const auto [s1, c1] = full_add(
+        BitBoard::shift<Direction::right>(board),
+        BitBoard::shift<Direction::upleft>(board),
+        BitBoard::shift<Direction::upright>(board)
+    );
+    const auto d0 = BitBoard::shift<Direction::downleft>(board);
+    const auto d1 = BitBoard::shift<Direction::downright>(board);
+
+    const auto [ones, c2] = full_add(s0, s1, d0 ^ d1);
+    const auto [s3, fours] = full_add(c0, c1, d0 & d1);
+    const auto overflow = s3 & c2;
+    return {ones, s3 ^ c2, fours ^ overflow, fours & overflow};
+}
+
+// Number of set squares in the 5x5 window around each square, excluding the square itself (0 to 24). Row sums
+// are built once and then added at each vertical offset.
+[[nodiscard]] constexpr CountPlanes<5> neighbor_counts_5x5(const BitBoard board) noexcept
+{
+    CountPlanes<5> row_counts;
+    row_counts = add_board(row_counts, BitBoard::shift<Direction::left, 2>(board));
+    row_counts = add_board(row_counts, BitBoard::shift<Direction::left, 1>(board));
+    row_counts = add_board(row_counts, board);
+    row_counts = add_board(row_counts, BitBoard::shift<Direction::right, 1>(board));
+    row_counts = add_board(row_counts, BitBoard::shift<Direction::right, 2>(board));
+
+    auto counts = row_counts;
+    counts = add_counts(counts, shift_counts<Direction::up, 1>(row_counts));
+    counts = add_counts(counts, shift_counts<Direction::up, 2>(row_counts));
+    counts = add_counts(counts, shift_counts<Direction::down, 1>(row_counts));
+    counts = add_counts(counts, shift_counts<Direction::down, 2>(row_counts));
+
+    // Remove each set square from its own window.
+    auto borrow = board;
+    for (auto& plane : counts) {
+        const auto difference = plane ^ borrow;
+        borrow &= ~plane;
+        plane = difference;
+    }
+    return counts;
+}
+
+// Squares whose count is at least k.
+template <std::size_t N>
+[[nodiscard]] constexpr BitBoard count_at_least(const CountPlanes<N>& counts, const std::size_t k) noexcept
+{
+    if ((k >> N) != 0) {
+        return BitBoard{};
+    }
+    BitBoard greater{};
+    auto equal = BitBoard::make_full();
+    for (std::size_t i = N; i-- > 0;) {
+        if (((k >> i) & 1) != 0) {
+            equal &= counts[i];
+        } else {
+            greater |= equal & counts[i];
+            equal &= ~counts[i];
+        }
+    }
+    return greater | equal;
+}
+
+template <std::size_t N>
+[[nodiscard]] constexpr BitBoard count_equal(const CountPlanes<N>& counts, const std::size_t k) noexcept
+{
+    if ((k >> N) != 0) {
+        return BitBoard{};
+    }
+    auto equal = BitBoard::make_full();
+    for (std::size_t i = 0; i < N; ++i) {
+        equal &= ((k >> i) & 1) != 0 ? counts[i] : ~counts[i];
+    }
+    return equal;
+}
+
+template <std::size_t N>
+[[nodiscard]] constexpr std::size_t count_at(const CountPlanes<N>& counts, const BitBoard::Position& position)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        count |= static_cast<std::size_t>(counts[i].test(position)) << i;
+    }
+    return count;
+}
@@ -0,0 +1,13 @@
+#include "playout.h"
+
+#include "bit_board.h"
+#include "kernels.h"
+
+#include <cstddef>
+
+BitBoard select_nth_set_bit(const BitBoard board, const std::size_t n) noexcept
+{
+    // Square order runs from the most significant bit, select_bit counts from the least significant.
+    const auto count = board.count();
+    return n < count ? BitBoard{kernels().select_bit(board.to_ullong(), count - 1 - n)} : BitBoard{};
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// xoshiro256** (Blackman and Vigna): 32 bytes of state, so every worker thread can own one.
+class Xoshiro256
+{
+  public:
+    using result_type = std::uint64_t;
+
+    constexpr explicit Xoshiro256(std::uint64_t seed) noexcept : state_{}
+    {
+        // splitmix64 spreads the seed so that nearby seeds give unrelated streams.
+        for (auto& word : state_) {
+            seed += 0x9e3779b97f4a7c15;
+            auto z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+    [[nodiscard]] static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        const auto result = std::rotl(state_[1] * 5, 7) * 9;
+        const auto t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = std::rotl(state_[3], 45);
+        return result;
+    }
+
+    // Advances by 2^128 draws; successive jumps give non-overlapping streams for parallel workers.
+    constexpr void jump() noexcept
+    {
+        constexpr std::array<std::uint64_t, 4> polynomial{
+            0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c
+        };
+        std::array<std::uint64_t, 4> jumped{};
+        for (const auto word : polynomial) {
+            for (std::size_t bit = 0; bit < 64; ++bit) {
+                if ((word >> bit) & 1) {
+                    for (std::size_t i = 0; i < jumped.size(); ++i) {
+                        jumped[i] ^= state_[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        state_ = jumped;
+    }
+
+    [[nodiscard]] constexpr friend bool operator==(const Xoshiro256& lhs, const Xoshiro256& rhs) noexcept = default;
+
+  private:
+    std::array<std::uint64_t, 4> state_;
+};
+
+// The n-th set square in square order (n = 0 is the first square to_bitboard_vector() would return), or an empty
+// board if fewer than n + 1 squares are set. Uses PDEP where available.
+[[nodiscard]] BitBoard select_nth_set_bit(BitBoard board, std::size_t n) noexcept;
+
+// A uniformly chosen set square, or an empty board if board is empty.
+template <std::uniform_random_bit_generator Rng>
+[[nodiscard]] BitBoard random_set_bit(const BitBoard board, Rng& rng)
+{
+    static_assert(Rng::max() - Rng::min() == std::numeric_limits<std::uint64_t>::max(), "needs 64 random bits");
+    const auto count = static_cast<std::uint64_t>(board.count());
+    // Multiply-shift reduction of the high 32 bits; the bias is below count / 2^32.
+    const auto n = ((static_cast<std::uint64_t>(rng() - Rng::min()) >> 32) * count) >> 32;
+    return select_nth_set_bit(board, static_cast<std::size_t>(n));
+}
+
+// A game the playout driver can play: moves() is the set of legal squares (empty once the game is over), play()
+// returns the successor state, and score() rates a finished game for the side to move (-1, 0 or 1).
+template <typename G>
+concept PlayoutGame = requires(const G& game, const typename G::State& state, BitBoard move) {
+    { game.moves(state) } -> std::same_as<BitBoard>;
+    { game.play(state, move) } -> std::same_as<typename G::State>;
+    { game.score(state) } -> std::convertible_to<int>;
+};
+
+struct PlayoutResult
+{
+    // From the point of view of the side to move in the starting state.
+    int score;
+    std::size_t plies;
+};
+
+struct PlayoutStats
+{
+    std::uint64_t playouts{0};
+    std::uint64_t wins{0};
+    std::uint64_t draws{0};
+    std::uint64_t losses{0};
+    std::uint64_t plies{0};
+
+    void add(const PlayoutResult& result) noexcept
+    {
+        ++playouts;
+        wins += result.score > 0;
+        draws += result.score == 0;
+        losses += result.score < 0;
+        plies += result.plies;
+    }
+    PlayoutStats& operator+=(const PlayoutStats& other) noexcept
+    {
+        playouts += other.playouts;
+        wins += other.wins;
+        draws += other.draws;
+        losses += other.losses;
+        plies += other.plies;
+        return *this;
+    }
+};
+
+// Plays uniformly random games. A driver owns its generator and works entirely on values, so one driver per
+// thread runs playouts without locking or allocating.
+template <PlayoutGame Game>
+class PlayoutDriver
+{
+  public:
+    using State = typename Game::State;
+
+    explicit PlayoutDriver(Game game, const std::uint64_t seed) noexcept : game_(std::move(game)), rng_(seed) {}
+    explicit PlayoutDriver(Game game, const Xoshiro256& rng) noexcept : game_(std::move(game)), rng_(rng) {}
+
+    [[nodiscard]] PlayoutResult run(State state, const std::size_t max_plies = BitBoard::n_bits)
+    {
+        std::size_t plies = 0;
+        for (; plies < max_plies; ++plies) {
+            const auto moves = game_.moves(state);
+            if (moves.empty()) {
+                break;
+            }
+            state = game_.play(state, random_set_bit(moves, rng_));
+        }
+        const int score = game_.score(state);
+        return {plies % 2 == 0 ? score : -score, plies};
+    }
+
+    [[nodiscard]] PlayoutStats run_batch(const State& state, const std::uint64_t n_playouts)
+    {
+        PlayoutStats stats;
+        for (std::uint64_t i = 0; i < n_playouts; ++i) {
+            stats.add(run(state));
+        }
+        return stats;
+    }
+
+    [[nodiscard]] Xoshiro256& rng() noexcept
+    {
+        return rng_;
+    }
+
+  private:
+    Game game_;
+    Xoshiro256 rng_;
+};
+
+// Splits n_playouts across threads, each with its own driver on a jumped stream of the seed.
+template <PlayoutGame Game>
+[[nodiscard]] PlayoutStats run_parallel_playouts(
+    const Game& game,
+    const typename Game::State& state,
+    const std::uint64_t n_playouts,
+    unsigned n_threads,
+    const std::uint64_t seed
+)
+{
+    if (n_threads == 0) {
+        n_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    std::vector<PlayoutStats> stats(n_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads);
+    Xoshiro256 rng{seed};
+    for (unsigned thread = 0; thread < n_threads; ++thread) {
+        const auto share = n_playouts / n_threads + (thread < n_playouts % n_threads ? 1 : 0);
+        threads.emplace_back([&game, &state, &result = stats[thread], share, rng] {
+            PlayoutDriver<Game> driver{game, rng};
+            result = driver.run_batch(state, share);
+        });
+        rng.jump();
+    }
+    PlayoutStats total;
+    for (std::size_t thread = 0; thread < threads.size(); ++thread) {
+        threads[thread].join();
+        total += stats[thread];
+    }
+    return total;
+}
+
+// Free-placement four in a row on the 8x8 board, used to exercise and measure the playout driver.
+struct FourInARow
+{
+    struct State
+    {
+        BitBoard to_move;
+        BitBoard waiting;
+    };
+
+    // Squares that start a run of four stones in direction D.
+    template <Direction D>
+    [[nodiscard]] static constexpr BitBoard runs_of_four(const BitBoard stones) noexcept
+    {
+        return stones & BitBoard::shift<D, 1>(stones) & BitBoard::shift<D, 2>(stones) & BitBoard::shift<D, 3>(stones);
+    }
+
+    [[nodiscard]] static constexpr bool has_four(const BitBoard stones) noexcept
+    {
+        return !(runs_of_four<Direction::right>(stones) | runs_of_four<Direction::down>(stones) |
+                 runs_of_four<Direction::downright>(stones) | runs_of_four<Direction::downleft>(stones))
+                    .empty();
+    }
+
+    [[nodiscard]] constexpr BitBoard moves(const State& state) const noexcept
+    {
+        return has_four(state.waiting) ? BitBoard{} : ~(state.to_move | state.waiting);
+    }
+    [[nodiscard]] constexpr State play(const State& state, const BitBoard move) const noexcept
+    {
+        return {state.waiting, state.to_move | move};
+    }
+    [[nodiscard]] constexpr int score(const State& state) const noexcept
+    {
+        return has_four(state.waiting) ? -1 : 0;
+    }
+};
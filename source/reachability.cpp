@@ -0,0 +1,14 @@
+#include "reachability.h"
+
+#include "kernels.h"
+
+#include <span>
+#include <stdexcept>
+
+void reach_batch(std::span<const ReachQuery> queries, std::span<ReachResult> results, const Neighborhood neighborhood)
+{
+    if (results.size() < queries.size()) {
+        throw std::invalid_argument("fewer results than queries");
+    }
+    kernels().reach_batch(queries, results, neighborhood);
+}
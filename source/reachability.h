@@ -0,0 +1,90 @@
+#pragma once
+
+#include "bit_board.h"
+#include "kernels.h"
+
+#include <cstddef>
+
+#include <span>
+
+// One flood fill: start from sources and repeatedly step into allowed squares until a target is reached, the
+// frontier dies out, or max_steps steps have been taken.
+struct ReachQuery
+{
+    BitBoard sources;
+    BitBoard allowed;
+    BitBoard targets;
+    std::size_t max_steps{BitBoard::n_bits};
+};
+
+struct ReachResult
+{
+    // Sources and every square found within steps steps.
+    BitBoard reached;
+    // Steps that found new squares: the distance to the nearest target on a hit, otherwise to the last ring.
+    std::size_t steps{0};
+    bool hit{false};
+
+    [[nodiscard]] friend bool operator==(const ReachResult& lhs, const ReachResult& rhs) noexcept = default;
+};
+
+// Squares one step from any square of frontier.
+[[nodiscard]] constexpr BitBoard step(const BitBoard frontier, const Neighborhood neighborhood) noexcept
+{
+    switch (neighborhood) {
+    case Neighborhood::cardinal:
+        return BitBoard::neighbors_cardinal(frontier);
+    case Neighborhood::diagonal:
+        return BitBoard::neighbors_diagonal(frontier);
+    case Neighborhood::cardinal_and_diagonal:
+        return BitBoard::neighbors_cardinal_and_diagonal(frontier);
+    }
+    return BitBoard{};
+}
+
+// Breadth-first flood fill for any move set: expand(frontier) returns the squares one move away, e.g.
+// knight_attacks. Only the newest ring is expanded each step, and the loop stops at the fixpoint instead of
+// running a fixed number of iterations.
+template <typename Expand>
+[[nodiscard]] constexpr ReachResult reach(const ReachQuery& query, Expand&& expand)
+{
+    ReachResult result{query.sources, 0, query.sources.test_any(query.targets)};
+    for (auto frontier = query.sources; !result.hit && result.steps < query.max_steps;) {
+        frontier = expand(frontier) & query.allowed & ~result.reached;
+        if (frontier.empty()) {
+            break;
+        }
+        result.reached |= frontier;
+        ++result.steps;
+        result.hit = frontier.test_any(query.targets);
+    }
+    return result;
+}
+
+[[nodiscard]] constexpr ReachResult reach(const ReachQuery& query, const Neighborhood neighborhood)
+{
+    return reach(query, [neighborhood](const BitBoard frontier) { return step(frontier, neighborhood); });
+}
+
+// Squares reachable from sources in at most k steps through allowed squares, sources included.
+[[nodiscard]] constexpr BitBoard reachable_within(
+    const BitBoard sources, const BitBoard allowed, const std::size_t k, const Neighborhood neighborhood
+)
+{
+    return reach(ReachQuery{sources, allowed, BitBoard{}, k}, neighborhood).reached;
+}
+
+// Whether to can be reached from from by steps through allowed squares; from itself need not be allowed.
+[[nodiscard]] constexpr bool connected(
+    const BitBoard::Position& from,
+    const BitBoard::Position& to,
+    const BitBoard allowed,
+    const Neighborhood neighborhood
+)
+{
+    return reach(ReachQuery{BitBoard{from}, allowed, BitBoard{to}}, neighborhood).hit;
+}
+
+// Answers independent queries together. The active kernels advance several frontiers per vector instruction and
+// retire each query as soon as it finishes; results match reach() query by query.
+void reach_batch(std::span<const ReachQuery> queries, std::span<ReachResult> results, Neighborhood neighborhood);
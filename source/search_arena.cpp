@@ -0,0 +1,50 @@
+#include "search_arena.h"
+
+#include "bit_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+
+SearchArena::SearchArena(const std::size_t capacity)
+    : storage_(std::make_unique_for_overwrite<BitBoard[]>(capacity)), capacity_(capacity)
+{
+}
+
+SearchArena& SearchArena::for_this_thread()
+{
+    thread_local SearchArena arena;
+    return arena;
+}
+
+std::span<BitBoard> SearchArena::allocate_boards(const std::size_t n)
+{
+    return {static_cast<BitBoard*>(allocate(n * sizeof(BitBoard), alignof(BitBoard))), n};
+}
+
+void* SearchArena::do_allocate(const std::size_t bytes, const std::size_t alignment)
+{
+    auto* const base = reinterpret_cast<std::byte*>(storage_.get());
+    const auto total_bytes = capacity_ * sizeof(BitBoard);
+    const auto address = reinterpret_cast<std::uintptr_t>(base + used_bytes_);
+    const auto padding = (alignment - address % alignment) % alignment;
+    if (padding > total_bytes - used_bytes_ || bytes > total_bytes - used_bytes_ - padding) {
+        throw std::bad_alloc();
+    }
+    void* const p = base + used_bytes_ + padding;
+    used_bytes_ += padding + bytes;
+    high_water_bytes_ = std::max(high_water_bytes_, used_bytes_);
+    return p;
+}
+
+void SearchArena::do_deallocate(void*, std::size_t, std::size_t) noexcept {}
+
+bool SearchArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
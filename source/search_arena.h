@@ -0,0 +1,52 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+
+#include <memory>
+#include <memory_resource>
+#include <span>
+
+// Bump allocator over a fixed buffer of BitBoard-sized slots. Deallocation is a no-op and reset()
+// releases everything at once, so scratch containers built on it never touch the heap after construction.
+class SearchArena : public std::pmr::memory_resource
+{
+  public:
+    static constexpr std::size_t default_capacity = std::size_t{1} << 16;
+
+    explicit SearchArena(std::size_t capacity = default_capacity);
+
+    [[nodiscard]] static SearchArena& for_this_thread();
+
+    // Capacity and usage are measured in BitBoard units.
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+    [[nodiscard]] std::size_t used() const noexcept
+    {
+        return (used_bytes_ + sizeof(BitBoard) - 1) / sizeof(BitBoard);
+    }
+    [[nodiscard]] std::size_t high_water_mark() const noexcept
+    {
+        return (high_water_bytes_ + sizeof(BitBoard) - 1) / sizeof(BitBoard);
+    }
+
+    [[nodiscard]] std::span<BitBoard> allocate_boards(std::size_t n);
+
+    void reset() noexcept
+    {
+        used_bytes_ = 0;
+    }
+
+  private:
+    std::unique_ptr<BitBoard[]> storage_;
+    std::size_t capacity_;
+    std::size_t used_bytes_{0};
+    std::size_t high_water_bytes_{0};
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
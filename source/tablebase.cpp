@@ -0,0 +1,327 @@
+#include "tablebase.h"
+
+#include "bit_board.h"
+#include "kernels.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <functional>
+#include <numeric>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Bits = BitBoard::Bits;
+
+constexpr std::size_t n_symmetries = 8;
+
+template <typename T>
+T load(const std::byte* source) noexcept
+{
+    T value{};
+    std::memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+template <typename T>
+void store(std::byte* destination, const T value) noexcept
+{
+    std::memcpy(destination, &value, sizeof(value));
+}
+
+BitBoard apply_symmetry(const BitBoard board, const std::size_t symmetry) noexcept
+{
+    switch (symmetry) {
+    case 1:
+        return BitBoard::flip_vertical(board);
+    case 2:
+        return BitBoard::flip_horizontal(board);
+    case 3:
+        return BitBoard::rotate_half_turn(board);
+    case 4:
+        return BitBoard::flip_diagonal(board);
+    case 5:
+        return BitBoard::flip_anti_diagonal(board);
+    case 6:
+        return BitBoard::rotate_clockwise(board);
+    case 7:
+        return BitBoard::rotate_counterclockwise(board);
+    default:
+        return board;
+    }
+}
+
+std::uint64_t checked_multiply(const std::uint64_t lhs, const std::uint64_t rhs)
+{
+    if (rhs != 0 && lhs > UINT64_MAX / rhs) {
+        throw std::invalid_argument("tablebase index space exceeds 64 bits");
+    }
+    return lhs * rhs;
+}
+
+} // namespace
+
+PlacementIndexer::PlacementIndexer(std::vector<std::size_t> group_sizes) : group_sizes_(std::move(group_sizes))
+{
+    if (group_sizes_.empty() || group_sizes_.size() > max_groups) {
+        throw std::invalid_argument("a placement needs between 1 and 8 groups");
+    }
+    if (std::find(group_sizes_.begin(), group_sizes_.end(), 0) != group_sizes_.end() ||
+        std::accumulate(group_sizes_.begin(), group_sizes_.end(), std::size_t{0}) > BitBoard::n_bits) {
+        throw std::invalid_argument("group sizes must be positive and fit on the board");
+    }
+
+    const auto first_size = group_sizes_[0];
+    for (std::uint64_t rank = 0; rank < binomial(BitBoard::n_bits, first_size); ++rank) {
+        const auto bits = unrank_combination(rank, first_size);
+        if (BitBoard::canonical(BitBoard{bits}).to_ullong() == bits) {
+            first_groups_.push_back(bits);
+        }
+    }
+    std::sort(first_groups_.begin(), first_groups_.end());
+
+    radices_.push_back(first_groups_.size());
+    size_ = first_groups_.size();
+    auto free_squares = BitBoard::n_bits - first_size;
+    for (std::size_t group = 1; group < group_sizes_.size(); ++group) {
+        radices_.push_back(binomial(free_squares, group_sizes_[group]));
+        size_ = checked_multiply(size_, radices_.back());
+        free_squares -= group_sizes_[group];
+    }
+}
+
+void PlacementIndexer::canonicalize(const std::span<BitBoard> placement) const noexcept
+{
+    // Only the symmetries that minimize the first group can win, so the others never transform later groups.
+    std::array<BitBoard, n_symmetries> firsts;
+    for (std::size_t symmetry = 0; symmetry < n_symmetries; ++symmetry) {
+        firsts[symmetry] = apply_symmetry(placement[0], symmetry);
+    }
+    const auto smallest = *std::min_element(firsts.begin(), firsts.end());
+    const auto n = placement.size();
+    std::array<BitBoard, max_groups> best;
+    std::array<BitBoard, max_groups> candidate;
+    bool found = false;
+    for (std::size_t symmetry = 0; symmetry < n_symmetries; ++symmetry) {
+        if (firsts[symmetry] != smallest) {
+            continue;
+        }
+        for (std::size_t group = 1; group < n; ++group) {
+            candidate[group] = apply_symmetry(placement[group], symmetry);
+        }
+        if (!found || std::lexicographical_compare(
+                          candidate.begin() + 1, candidate.begin() + n, best.begin() + 1, best.begin() + n
+                      )) {
+            best = candidate;
+            found = true;
+        }
+    }
+    placement[0] = smallest;
+    std::copy(best.begin() + 1, best.begin() + n, placement.begin() + 1);
+}
+
+std::uint64_t PlacementIndexer::index(const std::span<const BitBoard> placement) const
+{
+    if (placement.size() != group_sizes_.size()) {
+        throw std::invalid_argument("placement does not match group sizes");
+    }
+    const auto first = placement[0].to_ullong();
+    const auto found = std::lower_bound(first_groups_.begin(), first_groups_.end(), first);
+    if (placement[0].count() != group_sizes_[0] || found == first_groups_.end() || *found != first) {
+        throw std::invalid_argument("placement is not canonical");
+    }
+    const auto& active = kernels();
+    auto index = static_cast<std::uint64_t>(found - first_groups_.begin());
+    auto used = first;
+    for (std::size_t group = 1; group < group_sizes_.size(); ++group) {
+        const auto bits = placement[group].to_ullong();
+        if (placement[group].count() != group_sizes_[group] || (bits & used) != 0) {
+            throw std::invalid_argument("placement does not match group sizes");
+        }
+        index = index * radices_[group] + rank_combination(active.extract_bits(bits, ~used));
+        used |= bits;
+    }
+    return index;
+}
+
+void PlacementIndexer::placement(std::uint64_t index, const std::span<BitBoard> placement) const
+{
+    if (index >= size_ || placement.size() != group_sizes_.size()) {
+        throw std::out_of_range("placement index outside of table");
+    }
+    std::array<std::uint64_t, max_groups> ranks{};
+    for (auto group = group_sizes_.size(); group-- > 1;) {
+        ranks[group] = index % radices_[group];
+        index /= radices_[group];
+    }
+    const auto& active = kernels();
+    auto used = first_groups_[index];
+    placement[0] = BitBoard{used};
+    for (std::size_t group = 1; group < group_sizes_.size(); ++group) {
+        const auto bits = active.deposit_bits(unrank_combination(ranks[group], group_sizes_[group]), ~used);
+        placement[group] = BitBoard{bits};
+        used |= bits;
+    }
+}
+
+TablebaseView::TablebaseView(const std::span<const std::byte> bytes) noexcept
+    : bytes_(bytes), entries_(load<std::uint64_t>(bytes.data() + 24)), passes_(load<std::uint64_t>(bytes.data() + 32))
+{
+}
+
+TablebaseView TablebaseView::from_bytes(const std::span<const std::byte> bytes)
+{
+    if (bytes.size() < header_bytes || load<std::uint64_t>(bytes.data()) != format_magic) {
+        throw std::invalid_argument("not a tablebase image");
+    }
+    const auto n_groups = load<std::uint64_t>(bytes.data() + 8);
+    if (n_groups == 0 || n_groups > PlacementIndexer::max_groups) {
+        throw std::invalid_argument("corrupt tablebase header");
+    }
+    const auto packed = load<std::uint64_t>(bytes.data() + 16);
+    if (n_groups < PlacementIndexer::max_groups && (packed >> (8 * n_groups)) != 0) {
+        throw std::invalid_argument("corrupt tablebase header");
+    }
+    const TablebaseView view{bytes};
+    if (view.entries_ > bytes.size() * PackedOutcomes::entries_per_word ||
+        bytes.size() != header_bytes + n_sides * view.side_words() * sizeof(Bits)) {
+        throw std::invalid_argument("truncated tablebase image");
+    }
+
+    // Every orbit of first groups has at most eight members, so an image this size bounds the enumeration the
+    // indexer does before it is built.
+    const auto sizes = view.group_sizes();
+    std::size_t squares = 0;
+    for (const auto size : sizes) {
+        if (size == 0 || size > BitBoard::n_bits - squares) {
+            throw std::invalid_argument("corrupt tablebase group sizes");
+        }
+        squares += size;
+    }
+    if (binomial(BitBoard::n_bits, sizes[0]) / n_symmetries > view.entries_ ||
+        PlacementIndexer{sizes}.size() != view.entries_) {
+        throw std::invalid_argument("tablebase entries do not match its group sizes");
+    }
+    return view;
+}
+
+std::vector<std::size_t> TablebaseView::group_sizes() const
+{
+    const auto n_groups = load<std::uint64_t>(bytes_.data() + 8);
+    const auto packed = load<std::uint64_t>(bytes_.data() + 16);
+    std::vector<std::size_t> sizes;
+    for (std::size_t group = 0; group < n_groups; ++group) {
+        sizes.push_back(static_cast<std::size_t>((packed >> (8 * group)) & 0xff));
+    }
+    return sizes;
+}
+
+Outcome TablebaseView::outcome(const std::size_t side, const std::uint64_t index) const noexcept
+{
+    const auto word = side * side_words() + index / PackedOutcomes::entries_per_word;
+    return PackedOutcomes::extract(
+        load<std::uint64_t>(bytes_.data() + header_bytes + word * sizeof(Bits)), index % PackedOutcomes::entries_per_word
+    );
+}
+
+std::uint64_t TablebaseView::count(const std::size_t side, const Outcome outcome) const noexcept
+{
+    std::uint64_t count = 0;
+    for (std::uint64_t index = 0; index < entries_; ++index) {
+        count += this->outcome(side, index) == outcome;
+    }
+    return count;
+}
+
+Outcome TablebaseView::probe(
+    const PlacementIndexer& indexer, const std::span<const BitBoard> placement, const std::size_t side
+) const
+{
+    if (side >= n_sides || indexer.group_sizes() != group_sizes() || placement.size() > PlacementIndexer::max_groups) {
+        throw std::invalid_argument("placement does not match tablebase");
+    }
+    std::array<BitBoard, PlacementIndexer::max_groups> canonical;
+    const auto groups = std::span{canonical}.first(placement.size());
+    std::copy(placement.begin(), placement.end(), groups.begin());
+    indexer.canonicalize(groups);
+    return outcome(side, indexer.index(groups));
+}
+
+Tablebase Tablebase::from_outcomes(
+    const PlacementIndexer& indexer, const std::span<const PackedOutcomes, TablebaseView::n_sides> sides,
+    const std::uint64_t passes
+)
+{
+    std::uint64_t packed_sizes = 0;
+    for (std::size_t group = 0; group < indexer.group_sizes().size(); ++group) {
+        packed_sizes |= static_cast<std::uint64_t>(indexer.group_sizes()[group]) << (8 * group);
+    }
+    const auto side_bytes = sides[0].words().size_bytes();
+    std::vector<std::byte> storage(TablebaseView::header_bytes + TablebaseView::n_sides * side_bytes);
+    store<std::uint64_t>(storage.data(), TablebaseView::format_magic);
+    store<std::uint64_t>(storage.data() + 8, indexer.group_sizes().size());
+    store<std::uint64_t>(storage.data() + 16, packed_sizes);
+    store<std::uint64_t>(storage.data() + 24, indexer.size());
+    store<std::uint64_t>(storage.data() + 32, passes);
+    for (std::size_t side = 0; side < TablebaseView::n_sides; ++side) {
+        std::memcpy(storage.data() + TablebaseView::header_bytes + side * side_bytes, sides[side].words().data(), side_bytes);
+    }
+    return Tablebase{std::move(storage)};
+}
+
+Tablebase Tablebase::from_bytes(const std::span<const std::byte> bytes)
+{
+    static_cast<void>(TablebaseView::from_bytes(bytes));
+    return Tablebase{std::vector<std::byte>(bytes.begin(), bytes.end())};
+}
+
+void Tablebase::write(std::ostream& out) const
+{
+    out.write(reinterpret_cast<const char*>(storage_.data()), static_cast<std::streamsize>(storage_.size()));
+}
+
+std::uint64_t run_word_ranges(
+    const std::uint64_t n_words, unsigned threads, const std::function<std::uint64_t(std::uint64_t, std::uint64_t)>& work
+)
+{
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<std::uint64_t>(threads, std::max<std::uint64_t>(n_words, 1)));
+    if (threads == 1) {
+        return work(0, n_words);
+    }
+    std::vector<std::uint64_t> results(threads, 0);
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned thread = 0; thread < threads; ++thread) {
+        const auto first = n_words * thread / threads;
+        const auto last = n_words * (thread + 1) / threads;
+        workers.emplace_back([&, thread, first, last] {
+            try {
+                results[thread] = work(first, last);
+            } catch (...) {
+                errors[thread] = std::current_exception();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return std::accumulate(results.begin(), results.end(), std::uint64_t{0});
+}
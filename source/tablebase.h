@@ -0,0 +1,388 @@
+#pragma once
+
+#include "bit_board.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Pascal's triangle up to n = 64; every entry fits in 64 bits.
+inline constexpr auto binomial_table = [] {
+    std::array<std::array<std::uint64_t, BitBoard::n_bits + 1>, BitBoard::n_bits + 1> table{};
+    for (std::size_t n = 0; n < table.size(); ++n) {
+        table[n][0] = 1;
+        for (std::size_t k = 1; k <= n; ++k) {
+            table[n][k] = table[n - 1][k - 1] + (k < n ? table[n - 1][k] : 0);
+        }
+    }
+    return table;
+}();
+
+[[nodiscard]] constexpr std::uint64_t binomial(const std::size_t n, const std::size_t k) noexcept
+{
+    return k > n ? 0 : binomial_table[n][k];
+}
+
+// Combinatorial number system: a set of k bits c_1 < ... < c_k (counted from the least significant bit) has rank
+// C(c_1, 1) + ... + C(c_k, k), a dense index in [0, C(n, k)) for sets drawn from the low n bits.
+[[nodiscard]] constexpr std::uint64_t rank_combination(BitBoard::Bits bits) noexcept
+{
+    std::uint64_t rank = 0;
+    for (std::size_t i = 1; bits != 0; ++i) {
+        rank += binomial(static_cast<std::size_t>(std::countr_zero(bits)), i);
+        bits &= bits - 1;
+    }
+    return rank;
+}
+
+[[nodiscard]] constexpr BitBoard::Bits unrank_combination(std::uint64_t rank, const std::size_t k) noexcept
+{
+    BitBoard::Bits bits = 0;
+    std::size_t c = BitBoard::n_bits;
+    for (std::size_t i = k; i > 0; --i) {
+        do {
+            --c;
+        } while (binomial(c, i) > rank);
+        rank -= binomial(c, i);
+        bits |= BitBoard::Bits{1} << c;
+    }
+    return bits;
+}
+
+// Value of a position for the side to move. Positions start as draws and are only ever promoted to win or loss,
+// so each fits in two bits.
+enum class Outcome : std::uint8_t
+{
+    draw = 0,
+    win = 1,
+    loss = 2,
+    illegal = 3,
+};
+
+// Dense index over placements of disjoint piece groups, group i holding group_sizes[i] squares. The first group is
+// restricted to configurations that are canonical under the eight board symmetries, so canonicalize() must be
+// applied before index(); the remaining groups are ranked among the squares left free by earlier groups.
+class PlacementIndexer
+{
+  public:
+    static constexpr std::size_t max_groups = 8;
+
+    explicit PlacementIndexer(std::vector<std::size_t> group_sizes);
+
+    [[nodiscard]] std::uint64_t size() const noexcept
+    {
+        return size_;
+    }
+    [[nodiscard]] const std::vector<std::size_t>& group_sizes() const noexcept
+    {
+        return group_sizes_;
+    }
+
+    // Applies the board symmetry that makes the placement smallest, comparing groups in order.
+    void canonicalize(std::span<BitBoard> placement) const noexcept;
+
+    [[nodiscard]] std::uint64_t index(std::span<const BitBoard> placement) const;
+    void placement(std::uint64_t index, std::span<BitBoard> placement) const;
+
+  private:
+    std::vector<std::size_t> group_sizes_;
+    std::vector<BitBoard::Bits> first_groups_;
+    std::vector<std::uint64_t> radices_;
+    std::uint64_t size_{0};
+};
+
+// Two bits per position, 32 positions per word.
+class PackedOutcomes
+{
+  public:
+    static constexpr std::size_t entries_per_word = 32;
+
+    explicit PackedOutcomes(const std::uint64_t size) : words_((size + entries_per_word - 1) / entries_per_word, 0)
+    {
+    }
+
+    [[nodiscard]] Outcome get(const std::uint64_t index) const noexcept
+    {
+        return extract(words_[index / entries_per_word], index % entries_per_word);
+    }
+    void set(const std::uint64_t index, const Outcome outcome) noexcept
+    {
+        auto& word = words_[index / entries_per_word];
+        word = insert(word, index % entries_per_word, outcome);
+    }
+
+    [[nodiscard]] static constexpr Outcome extract(const std::uint64_t word, const std::size_t slot) noexcept
+    {
+        return static_cast<Outcome>((word >> (2 * slot)) & 3);
+    }
+    [[nodiscard]] static constexpr std::uint64_t insert(
+        const std::uint64_t word, const std::size_t slot, const Outcome outcome
+    ) noexcept
+    {
+        return (word & ~(std::uint64_t{3} << (2 * slot))) | (static_cast<std::uint64_t>(outcome) << (2 * slot));
+    }
+
+    [[nodiscard]] std::span<std::uint64_t> words() noexcept
+    {
+        return words_;
+    }
+    [[nodiscard]] std::span<const std::uint64_t> words() const noexcept
+    {
+        return words_;
+    }
+
+  private:
+    std::vector<std::uint64_t> words_;
+};
+
+// Read-only tablebase image: a header followed by the packed outcomes of each side to move. The layout is the same
+// in memory and on disk, so a file can be memory-mapped and probed in place.
+class TablebaseView
+{
+  public:
+    static constexpr std::uint64_t format_magic = 0x0031'4254'4242; // "BBTB1"
+    static constexpr std::size_t header_bytes = 8 * sizeof(std::uint64_t);
+    static constexpr std::size_t n_sides = 2;
+
+    constexpr TablebaseView() noexcept = default;
+
+    [[nodiscard]] static TablebaseView from_bytes(std::span<const std::byte> bytes);
+
+    [[nodiscard]] std::vector<std::size_t> group_sizes() const;
+    [[nodiscard]] std::uint64_t entries() const noexcept
+    {
+        return entries_;
+    }
+    [[nodiscard]] std::uint64_t passes() const noexcept
+    {
+        return passes_;
+    }
+
+    [[nodiscard]] Outcome outcome(std::size_t side, std::uint64_t index) const noexcept;
+    [[nodiscard]] std::uint64_t count(std::size_t side, Outcome outcome) const noexcept;
+
+    // Outcome of an arbitrary placement, which is canonicalized first.
+    [[nodiscard]] Outcome probe(const PlacementIndexer& indexer, std::span<const BitBoard> placement, std::size_t side)
+        const;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+    {
+        return bytes_;
+    }
+
+  private:
+    friend class Tablebase;
+
+    std::span<const std::byte> bytes_;
+    std::uint64_t entries_{0};
+    std::uint64_t passes_{0};
+
+    explicit TablebaseView(std::span<const std::byte> bytes) noexcept;
+
+    [[nodiscard]] std::size_t side_words() const noexcept
+    {
+        return (entries_ + PackedOutcomes::entries_per_word - 1) / PackedOutcomes::entries_per_word;
+    }
+};
+
+class Tablebase
+{
+  public:
+    [[nodiscard]] static Tablebase from_outcomes(
+        const PlacementIndexer& indexer, std::span<const PackedOutcomes, TablebaseView::n_sides> sides,
+        std::uint64_t passes
+    );
+    [[nodiscard]] static Tablebase from_bytes(std::span<const std::byte> bytes);
+
+    [[nodiscard]] TablebaseView view() const noexcept
+    {
+        return TablebaseView{storage_};
+    }
+
+    void write(std::ostream& out) const;
+
+  private:
+    std::vector<std::byte> storage_;
+
+    explicit Tablebase(std::vector<std::byte> storage) noexcept : storage_(std::move(storage)) {}
+};
+
+// A two-player game over placements of piece groups. terminal() decides positions that are over before any move;
+// a side with no successor has lost. Successors are passed to the visitor with the other side to move, and the
+// visitor returns false once it has seen enough.
+template <typename G>
+concept TablebaseGame = requires(
+    const G& game, std::span<const BitBoard> placement, std::size_t side,
+    const std::function<bool(std::span<const BitBoard>)>& visit
+) {
+    { game.group_sizes() } -> std::convertible_to<std::vector<std::size_t>>;
+    { game.legal(placement, side) } -> std::same_as<bool>;
+    { game.terminal(placement, side) } -> std::same_as<std::optional<Outcome>>;
+    game.for_each_successor(placement, side, visit);
+};
+
+struct TablebaseOptions
+{
+    // 0 uses every hardware thread.
+    unsigned threads{0};
+};
+
+// Splits [0, n_words) into contiguous ranges, runs work on each from its own thread and sums the results.
+std::uint64_t run_word_ranges(
+    std::uint64_t n_words, unsigned threads, const std::function<std::uint64_t(std::uint64_t, std::uint64_t)>& work
+);
+
+// Retrograde analysis by repeated passes: each pass updates one side's table from the other side's, which stays
+// fixed during the pass, so threads owning disjoint word ranges never race and the result does not depend on the
+// thread count. Iteration stops when a pass over both sides changes nothing.
+template <TablebaseGame Game>
+[[nodiscard]] Tablebase build_tablebase(const Game& game, const TablebaseOptions& options = {})
+{
+    const PlacementIndexer indexer{game.group_sizes()};
+    const auto n_groups = indexer.group_sizes().size();
+    std::array<PackedOutcomes, TablebaseView::n_sides> sides{PackedOutcomes{indexer.size()}, PackedOutcomes{indexer.size()}};
+    const auto n_words = sides[0].words().size();
+
+    // Runs update on every draw entry of one side; update returns the new outcome.
+    const auto sweep = [&](const std::size_t side, const auto& update) {
+        return run_word_ranges(n_words, options.threads, [&](const std::uint64_t first, const std::uint64_t last) {
+            const auto words = sides[side].words();
+            std::array<BitBoard, PlacementIndexer::max_groups> scratch;
+            const auto placement = std::span{scratch}.first(n_groups);
+            std::uint64_t changes = 0;
+            for (auto word_index = first; word_index < last; ++word_index) {
+                auto word = words[word_index];
+                for (std::size_t slot = 0; slot < PackedOutcomes::entries_per_word; ++slot) {
+                    const auto index = word_index * PackedOutcomes::entries_per_word + slot;
+                    if (index >= indexer.size() || PackedOutcomes::extract(word, slot) != Outcome::draw) {
+                        continue;
+                    }
+                    indexer.placement(index, placement);
+                    const auto outcome = update(std::span<const BitBoard>{placement}, side);
+                    if (outcome != Outcome::draw) {
+                        word = PackedOutcomes::insert(word, slot, outcome);
+                        ++changes;
+                    }
+                }
+                words[word_index] = word;
+            }
+            return changes;
+        });
+    };
+
+    for (std::size_t side = 0; side < TablebaseView::n_sides; ++side) {
+        sweep(side, [&](const std::span<const BitBoard> placement, const std::size_t to_move) {
+            if (!game.legal(placement, to_move)) {
+                return Outcome::illegal;
+            }
+            return game.terminal(placement, to_move).value_or(Outcome::draw);
+        });
+    }
+
+    std::uint64_t passes = 0;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (std::size_t side = 0; side < TablebaseView::n_sides; ++side) {
+            const auto& opponent = sides[1 - side];
+            const auto changes = sweep(side, [&](const std::span<const BitBoard> placement, const std::size_t to_move) {
+                bool any_move = false;
+                bool all_win = true;
+                bool found_loss = false;
+                std::array<BitBoard, PlacementIndexer::max_groups> successor;
+                game.for_each_successor(placement, to_move, [&](const std::span<const BitBoard> next) {
+                    any_move = true;
+                    const auto canonical = std::span{successor}.first(n_groups);
+                    std::copy(next.begin(), next.end(), canonical.begin());
+                    indexer.canonicalize(canonical);
+                    const auto reply = opponent.get(indexer.index(canonical));
+                    found_loss = reply == Outcome::loss;
+                    all_win = all_win && reply == Outcome::win;
+                    return !found_loss;
+                });
+                if (found_loss) {
+                    return Outcome::win;
+                }
+                return !any_move || all_win ? Outcome::loss : Outcome::draw;
+            });
+            changed = changed || changes != 0;
+        }
+        ++passes;
+    }
+    return Tablebase::from_outcomes(indexer, sides, passes);
+}
+
+// A robber moving like a king flees cops that step orthogonally. The cops win by stepping onto the robber; the
+// robber may not step onto a cop and loses when it cannot move. Placements are {robber, cops}.
+class CopsAndRobber
+{
+  public:
+    static constexpr std::size_t cops_to_move = 0;
+    static constexpr std::size_t robber_to_move = 1;
+
+    explicit CopsAndRobber(const std::size_t n_cops) noexcept : n_cops_(n_cops) {}
+
+    [[nodiscard]] std::vector<std::size_t> group_sizes() const
+    {
+        return {1, n_cops_};
+    }
+
+    [[nodiscard]] bool legal(std::span<const BitBoard>, std::size_t) const noexcept
+    {
+        return true;
+    }
+
+    [[nodiscard]] std::optional<Outcome> terminal(const std::span<const BitBoard> placement, const std::size_t side)
+        const noexcept
+    {
+        const auto robber = placement[0];
+        const auto cops = placement[1];
+        if (side == cops_to_move && BitBoard::neighbors_cardinal(robber).test_any(cops)) {
+            return Outcome::win;
+        }
+        return std::nullopt;
+    }
+
+    template <typename F>
+    void for_each_successor(const std::span<const BitBoard> placement, const std::size_t side, F&& visit) const
+    {
+        const auto robber = placement[0];
+        const auto cops = placement[1];
+        if (side == robber_to_move) {
+            for_each_square(BitBoard::neighbors_cardinal_and_diagonal(robber) & ~cops, [&](const BitBoard target) {
+                return visit(std::span<const BitBoard>{std::array{target, cops}});
+            });
+            return;
+        }
+        for_each_square(cops, [&](const BitBoard cop) {
+            const auto targets = BitBoard::neighbors_cardinal(cop) & ~cops & ~robber;
+            return for_each_square(targets, [&](const BitBoard target) {
+                return visit(std::span<const BitBoard>{std::array{robber, (cops & ~cop) | target}});
+            });
+        });
+    }
+
+  private:
+    std::size_t n_cops_;
+
+    // Calls f on each set square until it returns false; returns false if it was stopped.
+    template <typename F>
+    static bool for_each_square(const BitBoard board, F&& f)
+    {
+        for (auto bits = board.to_ullong(); bits != 0; bits &= bits - 1) {
+            if (!f(BitBoard{bits & (~bits + 1)})) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "bit_board.h"
+#include "kernels.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+template <std::size_t Rows, std::size_t Columns>
+class WideBitBoard
+{
+  public:
+    using Position = BitBoard::Position;
+    using Bits = BitBoard::Bits;
+
+    static_assert(Rows > 0 && Columns > 0, "board must not be empty");
+    static_assert(Columns <= BitBoard::n_bits, "each row must fit in one word");
+
+    static constexpr std::size_t rows = Rows;
+    static constexpr std::size_t columns = Columns;
+    static constexpr std::size_t n_bits = Rows * Columns;
+    static constexpr std::size_t words_per_vector = 4;
+    static constexpr std::size_t n_words = (Rows + 2 + words_per_vector - 1) / words_per_vector * words_per_vector;
+    static constexpr Bits row_mask = Columns == BitBoard::n_bits ? ~Bits{0} : (Bits{1} << Columns) - 1;
+
+    constexpr explicit WideBitBoard() noexcept : words_{} {}
+    constexpr explicit WideBitBoard(const Position& position) : WideBitBoard()
+    {
+        set(position);
+    }
+
+    static constexpr WideBitBoard make_full() noexcept
+    {
+        WideBitBoard board;
+        for (std::size_t row = 0; row < Rows; ++row) {
+            board.row_word(row) = row_mask;
+        }
+        return board;
+    }
+    static constexpr WideBitBoard make_row(const std::size_t n) noexcept
+    {
+        assert(n < Rows);
+        WideBitBoard board;
+        board.row_word(n) = row_mask;
+        return board;
+    }
+    static constexpr WideBitBoard make_column(const std::size_t n) noexcept
+    {
+        assert(n < Columns);
+        WideBitBoard board;
+        for (std::size_t row = 0; row < Rows; ++row) {
+            board.row_word(row) = column_bit(n);
+        }
+        return board;
+    }
+    static constexpr WideBitBoard make_all_edge() noexcept
+    {
+        return make_row(0) | make_row(Rows - 1) | make_column(0) | make_column(Columns - 1);
+    }
+
+    template <Direction D>
+    [[nodiscard]] static constexpr WideBitBoard shift(WideBitBoard board, const std::size_t n = 1) noexcept
+    {
+        return board.shift_assign<D>(n);
+    }
+
+    [[nodiscard]] static WideBitBoard neighbors_cardinal(const WideBitBoard& board) noexcept
+    {
+        return neighbors(board, Neighborhood::cardinal);
+    }
+    [[nodiscard]] static WideBitBoard neighbors_diagonal(const WideBitBoard& board) noexcept
+    {
+        return neighbors(board, Neighborhood::diagonal);
+    }
+    [[nodiscard]] static WideBitBoard neighbors_cardinal_and_diagonal(const WideBitBoard& board) noexcept
+    {
+        return neighbors(board, Neighborhood::cardinal_and_diagonal);
+    }
+
+    [[nodiscard]] static WideBitBoard flood_fill(WideBitBoard seed, const WideBitBoard& allowed) noexcept
+    {
+        seed &= allowed;
+        for (;;) {
+            const auto grown = (seed | neighbors_cardinal(seed)) & allowed;
+            if (grown == seed) {
+                return seed;
+            }
+            seed = grown;
+        }
+    }
+
+    [[nodiscard]] constexpr bool test(const Position& position) const
+    {
+        check_position(position);
+        return (row_word(position.x()) & column_bit(position.y())) != 0;
+    }
+
+    [[nodiscard]] constexpr bool test_any(const WideBitBoard& other) const noexcept
+    {
+        return !(*this & other).empty();
+    }
+
+    [[nodiscard]] constexpr bool test_all(const WideBitBoard& other) const noexcept
+    {
+        return (*this & other) == other;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return std::all_of(words_.begin(), words_.end(), [](const Bits word) { return word == 0; });
+    }
+
+    [[nodiscard]] constexpr std::size_t count() const noexcept
+    {
+        if (!std::is_constant_evaluated()) {
+            return kernels().count_words(words_);
+        }
+        std::size_t total = 0;
+        for (const auto word : words_) {
+            total += std::popcount(word);
+        }
+        return total;
+    }
+
+    constexpr WideBitBoard& set(const WideBitBoard& other) noexcept
+    {
+        return *this |= other;
+    }
+
+    constexpr WideBitBoard& set(const Position& position)
+    {
+        check_position(position);
+        row_word(position.x()) |= column_bit(position.y());
+        return *this;
+    }
+
+    constexpr WideBitBoard& clear(const WideBitBoard& other) noexcept
+    {
+        return *this &= ~other;
+    }
+
+    constexpr WideBitBoard& clear(const Position& position)
+    {
+        check_position(position);
+        row_word(position.x()) &= ~column_bit(position.y());
+        return *this;
+    }
+
+    constexpr WideBitBoard& clear_all() noexcept
+    {
+        words_.fill(0);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr bool on_any_edge() const noexcept
+    {
+        return test_any(make_all_edge());
+    }
+
+    template <Direction D>
+    constexpr WideBitBoard& shift_assign(std::size_t n = 1) noexcept
+    {
+        if constexpr (D == Direction::up || D == Direction::down) {
+            n = std::min(n, Rows);
+            for (std::size_t step = 0; step < Rows; ++step) {
+                const auto row = D == Direction::up ? step : Rows - 1 - step;
+                const bool inside = step + n < Rows;
+                const auto source = D == Direction::up ? row + n : row - n;
+                row_word(row) = inside ? row_word(source) : 0;
+            }
+        } else if constexpr (D == Direction::left) {
+            for (std::size_t row = 0; row < Rows; ++row) {
+                row_word(row) = n >= Columns ? 0 : (row_word(row) << n) & row_mask;
+            }
+        } else if constexpr (D == Direction::right) {
+            for (std::size_t row = 0; row < Rows; ++row) {
+                row_word(row) = n >= Columns ? 0 : row_word(row) >> n;
+            }
+        } else if constexpr (D == Direction::upright) {
+            shift_assign<Direction::up>(n).template shift_assign<Direction::right>(n);
+        } else if constexpr (D == Direction::upleft) {
+            shift_assign<Direction::up>(n).template shift_assign<Direction::left>(n);
+        } else if constexpr (D == Direction::downright) {
+            shift_assign<Direction::down>(n).template shift_assign<Direction::right>(n);
+        } else if constexpr (D == Direction::downleft) {
+            shift_assign<Direction::down>(n).template shift_assign<Direction::left>(n);
+        }
+        return *this;
+    }
+
+    template <Direction D>
+    constexpr WideBitBoard& dilate() noexcept
+    {
+        return *this |= shift<D>(*this);
+    }
+
+    template <Direction D>
+    constexpr WideBitBoard& dilate(const std::size_t n) noexcept
+    {
+        for (std::size_t i = 0; i < n; i++) {
+            dilate<D>();
+        }
+        return *this;
+    }
+
+    template <typename F>
+    constexpr void for_each_position(F&& f) const
+    {
+        for (std::size_t row = 0; row < Rows; ++row) {
+            for (auto bits = row_word(row); bits != 0;) {
+                const auto column = static_cast<std::size_t>(std::countl_zero(bits)) - (BitBoard::n_bits - Columns);
+                bits &= ~column_bit(column);
+                f(Position{static_cast<int>(row), static_cast<int>(column)});
+            }
+        }
+    }
+
+    [[nodiscard]] std::vector<Position> to_position_vector() const
+    {
+        std::vector<Position> positions;
+        positions.reserve(count());
+        for_each_position([&](const Position& position) { positions.push_back(position); });
+        return positions;
+    }
+
+    [[nodiscard]] constexpr Bits row_bits(const std::size_t row) const noexcept
+    {
+        return row_word(row);
+    }
+
+    [[nodiscard]] constexpr std::span<const Bits, n_words> words() const noexcept
+    {
+        return words_;
+    }
+
+    constexpr WideBitBoard& operator|=(const WideBitBoard& other) noexcept
+    {
+        for (std::size_t i = 0; i < n_words; ++i) {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
+    [[nodiscard]] constexpr WideBitBoard operator|(const WideBitBoard& other) const noexcept
+    {
+        return WideBitBoard{*this} |= other;
+    }
+    constexpr WideBitBoard& operator&=(const WideBitBoard& other) noexcept
+    {
+        for (std::size_t i = 0; i < n_words; ++i) {
+            words_[i] &= other.words_[i];
+        }
+        return *this;
+    }
+    [[nodiscard]] constexpr WideBitBoard operator&(const WideBitBoard& other) const noexcept
+    {
+        return WideBitBoard{*this} &= other;
+    }
+    constexpr WideBitBoard& operator^=(const WideBitBoard& other) noexcept
+    {
+        for (std::size_t i = 0; i < n_words; ++i) {
+            words_[i] ^= other.words_[i];
+        }
+        return *this;
+    }
+    [[nodiscard]] constexpr WideBitBoard operator^(const WideBitBoard& other) const noexcept
+    {
+        return WideBitBoard{*this} ^= other;
+    }
+    [[nodiscard]] constexpr WideBitBoard operator~() const noexcept
+    {
+        return make_full() ^ *this;
+    }
+
+    [[nodiscard]] constexpr friend bool operator==(const WideBitBoard& lhs, const WideBitBoard& rhs) noexcept
+    {
+        return lhs.words_ == rhs.words_;
+    }
+    [[nodiscard]] constexpr friend bool operator!=(const WideBitBoard& lhs, const WideBitBoard& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+  private:
+    alignas(words_per_vector * sizeof(Bits)) std::array<Bits, n_words> words_;
+
+    static constexpr Bits column_bit(const std::size_t column) noexcept
+    {
+        return Bits{1} << (Columns - 1 - column);
+    }
+
+    static constexpr void check_position(const Position& position)
+    {
+        if (position.x() < 0 || position.x() >= static_cast<int>(Rows) || position.y() < 0 ||
+            position.y() >= static_cast<int>(Columns)) {
+            throw std::invalid_argument("position outside of board");
+        }
+    }
+
+    constexpr Bits& row_word(const std::size_t row) noexcept
+    {
+        return words_[row + 1];
+    }
+    constexpr const Bits& row_word(const std::size_t row) const noexcept
+    {
+        return words_[row + 1];
+    }
+
+    static WideBitBoard neighbors(const WideBitBoard& board, const Neighborhood neighborhood) noexcept
+    {
+        WideBitBoard result;
+        kernels().row_neighbors(board.words_, result.words_, Rows, row_mask, neighborhood);
+        return result;
+    }
+};
+
+using GoBitBoard = WideBitBoard<19, 19>;
@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+
+#include "attack_map.h"
+#include "bit_board.h"
+
+#include <array>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using Position = BitBoard::Position;
+
+static constexpr std::array patterns{
+    AttackPattern::cardinal_slider,
+    AttackPattern::diagonal_slider,
+    AttackPattern::cardinal_and_diagonal_slider,
+    AttackPattern::step,
+};
+
+static Position random_position(std::mt19937_64& rng)
+{
+    return Position{static_cast<int>(rng() % 8), static_cast<int>(rng() % 8)};
+}
+
+static void expect_matches_rebuild(const AttackMap& map)
+{
+    auto rebuilt = map;
+    rebuilt.rebuild();
+    ASSERT_EQ(map, rebuilt);
+}
+
+TEST(AttackMap, RaysAndBetween)
+{
+    EXPECT_EQ(ray(Position{0, 0}, right), (BitBoard::make_top_edge() & ~BitBoard{Position{0, 0}}));
+    EXPECT_EQ(ray(Position{3, 3}, downright).count(), 4);
+    EXPECT_EQ(ray(Position{0, 5}, up), BitBoard{});
+    EXPECT_EQ(between(Position{0, 0}, Position{3, 3}), (BitBoard{Position{1, 1}} | BitBoard{Position{2, 2}}));
+    EXPECT_EQ(between(Position{5, 1}, Position{5, 7}).count(), 5);
+    EXPECT_EQ(between(Position{0, 0}, Position{1, 2}), BitBoard{});
+    EXPECT_EQ(between(Position{4, 4}, Position{4, 5}), BitBoard{});
+    EXPECT_THROW(static_cast<void>(ray(Position{8, 0}, up)), std::invalid_argument);
+}
+
+TEST(AttackMap, AttacksFrom)
+{
+    const BitBoard occupancy{Position{3, 6}};
+    const auto attacks = attacks_from(Position{3, 3}, AttackPattern::cardinal_slider, occupancy);
+    EXPECT_EQ(attacks.count(), 7 + 3 + 3);
+    EXPECT_TRUE(attacks.test(Position{3, 6}));
+    EXPECT_FALSE(attacks.test(Position{3, 7}));
+    EXPECT_EQ(attacks_from(Position{0, 0}, AttackPattern::step, occupancy).count(), 3);
+    EXPECT_EQ(attacks_from(Position{0, 0}, AttackPattern::diagonal_slider, BitBoard{}).count(), 7);
+}
+
+TEST(AttackMap, BlockingAndUnblocking)
+{
+    AttackMap map;
+    map.place(Position{0, 0}, AttackPattern::cardinal_slider);
+    EXPECT_TRUE(map.attackers(Position{0, 7}).test(Position{0, 0}));
+
+    map.place(Position{0, 4}, AttackPattern::step);
+    EXPECT_TRUE(map.attackers(Position{0, 4}).test(Position{0, 0}));
+    EXPECT_TRUE(map.attackers(Position{0, 7}).empty());
+    EXPECT_EQ(map.attacks(Position{0, 0}).count(), 4 + 7);
+
+    map.remove(Position{0, 4});
+    EXPECT_TRUE(map.attackers(Position{0, 7}).test(Position{0, 0}));
+    EXPECT_EQ(map.attacks(Position{0, 0}).count(), 14);
+    expect_matches_rebuild(map);
+
+    EXPECT_THROW(map.place(Position{0, 0}, AttackPattern::step), std::invalid_argument);
+    EXPECT_THROW(map.remove(Position{5, 5}), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(map.make_move(Position{5, 5}, Position{5, 6})), std::invalid_argument);
+}
+
+TEST(AttackMap, RandomMovesMatchFullRecomputation)
+{
+    std::mt19937_64 rng{37};
+    for (int game = 0; game < 50; ++game) {
+        AttackMap map;
+        for (int i = 0; i < 16; ++i) {
+            const auto position = random_position(rng);
+            if (map.pattern(position) == AttackPattern::none) {
+                map.place(position, patterns[rng() % patterns.size()]);
+            }
+        }
+        expect_matches_rebuild(map);
+
+        std::vector<AttackMap> history;
+        std::vector<AttackMap::Undo> undos;
+        for (int ply = 0; ply < 60; ++ply) {
+            std::vector<Position> pieces;
+            map.occupancy().to_position_set(std::back_inserter(pieces));
+            if (pieces.size() < 2 || (!undos.empty() && rng() % 4 == 0)) {
+                if (undos.empty()) {
+                    break;
+                }
+                map.unmake_move(undos.back());
+                undos.pop_back();
+                ASSERT_EQ(map, history.back());
+                history.pop_back();
+                continue;
+            }
+            const auto from = pieces[rng() % pieces.size()];
+            const auto to = random_position(rng);
+            if (to == from) {
+                continue;
+            }
+            history.push_back(map);
+            undos.push_back(map.make_move(from, to));
+            expect_matches_rebuild(map);
+
+            BitBoard attacked{};
+            for (const auto& piece : pieces) {
+                const auto pattern = map.pattern(piece);
+                if (pattern != AttackPattern::none) {
+                    ASSERT_EQ(map.attacks(piece), attacks_from(piece, pattern, map.occupancy()));
+                    attacked |= map.attacks(piece);
+                }
+            }
+            attacked |= map.attacks(to);
+            ASSERT_EQ(map.attacked(), attacked);
+        }
+        while (!undos.empty()) {
+            map.unmake_move(undos.back());
+            undos.pop_back();
+            ASSERT_EQ(map, history.back());
+            history.pop_back();
+        }
+    }
+}
@@ -3,7 +3,13 @@
 #include "bit_board.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 class BitBoardShiftTest : public ::testing::Test
 {};
@@ -358,6 +364,86 @@ TEST(BoardDynamicShift, ShiftAll)
     }
 }
 
+TEST(BoardDynamicShift, PastTheEdgeClearsBoard)
+{
+    for (const auto direction : {Direction::right, Direction::upright, Direction::up, Direction::upleft,
+                                 Direction::left, Direction::downleft, Direction::down, Direction::downright}) {
+        for (const std::size_t n : {8, 9, 64, 1000}) {
+            EXPECT_TRUE(BitBoard::shift(BitBoard::make_full(), direction, n).empty());
+        }
+    }
+    EXPECT_TRUE(BitBoard::shift(BitBoard::make_full(), BitBoard::Position{-8, 0}).empty());
+    EXPECT_TRUE(BitBoard::shift(BitBoard::make_full(), BitBoard::Position{0, 100}).empty());
+}
+
+static const std::vector<BitBoard> constant_shift_boards{
+    test_board, BitBoard{0x0123456789abcdef}, BitBoard::make_full(), BitBoard::make_all_edge()
+};
+
+template <Direction D, std::size_t N>
+static void expect_constant_shift(const BitBoard board)
+{
+    EXPECT_EQ((BitBoard::shift<D, N>(board)), BitBoard::shift<D>(board, N));
+    EXPECT_EQ((BitBoard{board}.shift_assign<D, N>()), BitBoard::shift<D>(board, N));
+    EXPECT_EQ((BitBoard{board}.dilate<D, N>()), BitBoard{board}.dilate<D>(N));
+}
+
+template <Direction D, std::size_t... N>
+static void expect_constant_shifts(std::index_sequence<N...>)
+{
+    for (const auto board : constant_shift_boards) {
+        (expect_constant_shift<D, N>(board), ...);
+    }
+}
+
+TEST(BoardConstantShift, MatchesRuntimeShift)
+{
+    constexpr auto amounts = std::make_index_sequence<BitBoard::board_size>{};
+    expect_constant_shifts<Direction::right>(amounts);
+    expect_constant_shifts<Direction::upright>(amounts);
+    expect_constant_shifts<Direction::up>(amounts);
+    expect_constant_shifts<Direction::upleft>(amounts);
+    expect_constant_shifts<Direction::left>(amounts);
+    expect_constant_shifts<Direction::downleft>(amounts);
+    expect_constant_shifts<Direction::down>(amounts);
+    expect_constant_shifts<Direction::downright>(amounts);
+}
+
+template <int DX, int DY>
+static void expect_offset_shift(const BitBoard board)
+{
+    EXPECT_EQ((BitBoard::shift(board, Offset<DX, DY>{})), BitBoard::shift(board, BitBoard::Position{DX, DY}));
+}
+
+template <int DX, std::size_t... I>
+static void expect_offset_shifts(std::index_sequence<I...>)
+{
+    for (const auto board : constant_shift_boards) {
+        (expect_offset_shift<DX, 1 - BitBoard::board_size + static_cast<int>(I)>(board), ...);
+    }
+}
+
+template <std::size_t... I>
+static void expect_offset_rows(std::index_sequence<I...> offsets)
+{
+    (expect_offset_shifts<1 - BitBoard::board_size + static_cast<int>(I)>(offsets), ...);
+}
+
+TEST(BoardConstantShift, OffsetMatchesPositionShift)
+{
+    expect_offset_rows(std::make_index_sequence<2 * BitBoard::board_size - 1>{});
+    EXPECT_TRUE(BitBoard::shift(BitBoard::make_full(), Offset<BitBoard::board_size, 0>{}).empty());
+    EXPECT_TRUE(BitBoard::shift(BitBoard::make_full(), Offset<0, -BitBoard::board_size>{}).empty());
+}
+
+TEST(BoardConstantShift, RowsAndColumns)
+{
+    EXPECT_EQ(BitBoard::make_row<0>(), BitBoard::make_top_edge());
+    EXPECT_EQ(BitBoard::make_row<5>(), BitBoard::make_row(5));
+    EXPECT_EQ(BitBoard::make_column<7>(), BitBoard::make_right_edge());
+    EXPECT_EQ(BitBoard::make_column<3>(), BitBoard::make_column(3));
+}
+
 TEST(BoardCardinalNeighbors, Middle)
 {
     const auto neighbors = BitBoard::neighbors_cardinal({4, 4});
@@ -421,3 +507,95 @@ TEST(BoardCardinalAndDiagonalNeighbors, Middle)
     EXPECT_TRUE(neighbors.test({5, 5}));
     EXPECT_EQ(neighbors.count(), 8);
 }
+
+static BitBoard transform_positions(const BitBoard board, BitBoard::Position (*transform)(BitBoard::Position))
+{
+    BitBoard transformed;
+    for (const auto& position : board.to_position_vector()) {
+        transformed.set(transform(position));
+    }
+    return transformed;
+}
+
+TEST(BoardSymmetry, MatchesPositionTransforms)
+{
+    using Position = BitBoard::Position;
+    constexpr int last = BitBoard::board_size - 1;
+    const std::vector<BitBoard> boards{test_board, right_board, BitBoard{0x0123456789abcdef}, BitBoard::make_top_left()};
+    for (const auto board : boards) {
+        EXPECT_EQ(BitBoard::flip_vertical(board), transform_positions(board, [](Position p) {
+                      return Position{last - p.x(), p.y()};
+                  }));
+        EXPECT_EQ(BitBoard::flip_horizontal(board), transform_positions(board, [](Position p) {
+                      return Position{p.x(), last - p.y()};
+                  }));
+        EXPECT_EQ(BitBoard::flip_diagonal(board), transform_positions(board, [](Position p) {
+                      return Position{p.y(), p.x()};
+                  }));
+        EXPECT_EQ(BitBoard::flip_anti_diagonal(board), transform_positions(board, [](Position p) {
+                      return Position{last - p.y(), last - p.x()};
+                  }));
+        EXPECT_EQ(BitBoard::rotate_clockwise(board), transform_positions(board, [](Position p) {
+                      return Position{p.y(), last - p.x()};
+                  }));
+        EXPECT_EQ(BitBoard::rotate_counterclockwise(board), transform_positions(board, [](Position p) {
+                      return Position{last - p.y(), p.x()};
+                  }));
+        EXPECT_EQ(BitBoard::rotate_half_turn(board), transform_positions(board, [](Position p) {
+                      return Position{last - p.x(), last - p.y()};
+                  }));
+    }
+}
+
+TEST(BoardSymmetry, CanonicalIsSharedByAllSymmetries)
+{
+    const BitBoard board{0x0000'1038'0400'0000};
+    const auto canonical = BitBoard::canonical(board);
+    EXPECT_LE(canonical, board);
+    EXPECT_EQ(BitBoard::canonical(BitBoard::rotate_clockwise(board)), canonical);
+    EXPECT_EQ(BitBoard::canonical(BitBoard::flip_anti_diagonal(board)), canonical);
+    EXPECT_EQ(BitBoard::canonical(BitBoard::flip_horizontal(board)), canonical);
+}
+
+namespace constexpr_checks {
+
+constexpr auto checkered = "10101010"
+                           "01010101"
+                           "10101010"
+                           "01010101"
+                           "10101010"
+                           "01010101"
+                           "10101010"
+                           "01010101"_bb;
+
+constexpr auto king_moves = [] {
+    std::array<BitBoard, BitBoard::n_bits> moves;
+    for (int row = 0; row < BitBoard::board_size; ++row) {
+        for (int column = 0; column < BitBoard::board_size; ++column) {
+            moves[row * BitBoard::board_size + column] =
+                BitBoard::neighbors_cardinal_and_diagonal(BitBoard::Position{row, column});
+        }
+    }
+    return moves;
+}();
+
+static_assert(checkered.count() == 32);
+static_assert(checkered.test({0, 0}) && !checkered.test({0, 1}));
+static_assert(BitBoard::shift(checkered, Direction::down) == BitBoard::shift<Direction::down>(checkered));
+static_assert(BitBoard::shift(BitBoard::make_top_left(), BitBoard::Position{7, 7}) == BitBoard::make_bottom_right());
+static_assert(BitBoard{BitBoard::make_top_left()}.dilate(Direction::right, 7) == BitBoard::make_top_edge());
+static_assert(BitBoard::make_top_right().on_edge(Direction::up) && !BitBoard{checkered}.clear(checkered).on_any_edge());
+static_assert(BitBoard{}.set({3, 4}).set({4, 4}).clear({3, 4}) == BitBoard{BitBoard::Position{4, 4}});
+static_assert(king_moves[0].count() == 3 && king_moves[9].count() == 8);
+static_assert(BitBoard::flip_diagonal(BitBoard::make_top_edge()) == BitBoard::make_left_edge());
+static_assert(BitBoard::canonical(BitBoard::make_bottom_right()) == BitBoard::make_bottom_right());
+static_assert(BitBoard::shift<Direction::downright, 7>(BitBoard::make_top_left()) == BitBoard::make_bottom_right());
+static_assert(BitBoard::shift(checkered, Offset<2, -3>{}) == BitBoard::shift(checkered, BitBoard::Position{2, -3}));
+
+} // namespace constexpr_checks
+
+TEST(BoardLiteral, MatchesStringConstructor)
+{
+    EXPECT_EQ(constexpr_checks::checkered, test_board);
+    EXPECT_THROW(BitBoard{std::string_view{"0101"}}, std::invalid_argument);
+}
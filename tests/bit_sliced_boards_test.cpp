@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "bit_sliced_boards.h"
+#include "cpu_features.h"
+#include "kernels.h"
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using Bits = BitBoard::Bits;
+
+static std::array<BitBoard, 64> random_block(std::mt19937_64& rng)
+{
+    std::array<BitBoard, 64> boards;
+    for (auto& board : boards) {
+        board = BitBoard{rng() & rng()};
+    }
+    return boards;
+}
+
+TEST(BitSlicedBoards, TransposeAllLevels)
+{
+    std::mt19937_64 rng{35};
+    std::array<Bits, 64> rows;
+    for (auto& row : rows) {
+        row = rng();
+    }
+    std::array<Bits, 64> expected{};
+    for (std::size_t row = 0; row < 64; ++row) {
+        for (std::size_t column = 0; column < 64; ++column) {
+            if ((rows[row] >> (63 - column)) & 1) {
+                expected[column] |= Bits{1} << (63 - row);
+            }
+        }
+    }
+
+    for (auto level = CpuLevel::generic; level <= detected_cpu_level();
+         level = static_cast<CpuLevel>(static_cast<int>(level) + 1)) {
+        SCOPED_TRACE(to_string(level));
+        std::array<Bits, 64> transposed{};
+        kernels_for(level).transpose_64x64(rows, transposed);
+        EXPECT_EQ(transposed, expected);
+
+        auto in_place = rows;
+        kernels_for(level).transpose_64x64(in_place, in_place);
+        EXPECT_EQ(in_place, expected);
+    }
+}
+
+TEST(BitSlicedBoards, RoundTrip)
+{
+    std::mt19937_64 rng{35};
+    const auto boards = random_block(rng);
+    const BitSlicedBoards sliced{boards};
+
+    std::array<BitBoard, 64> restored;
+    sliced.to_boards(restored);
+    EXPECT_EQ(restored, boards);
+
+    const BitSlicedBoards partial{std::span{boards}.first(3)};
+    partial.to_boards(restored);
+    EXPECT_EQ(restored[2], boards[2]);
+    EXPECT_EQ(restored[3], BitBoard{});
+
+    const std::vector<BitBoard> too_many(65, BitBoard{});
+    EXPECT_THROW(BitSlicedBoards{too_many}, std::invalid_argument);
+}
+
+TEST(BitSlicedBoards, SquareQueries)
+{
+    std::mt19937_64 rng{35};
+    const auto boards = random_block(rng);
+    const BitSlicedBoards sliced{boards};
+    const BitBoard mask{0x0000'1800'0018'0000};
+
+    for (std::size_t b = 0; b < 64; ++b) {
+        const auto lane = BitSlicedBoards::lane(b);
+        EXPECT_EQ((sliced.square(BitBoard::Position{2, 5}) & lane) != 0, boards[b].test(BitBoard::Position{2, 5}));
+        EXPECT_EQ((sliced.any_of(mask) & lane) != 0, boards[b].test_any(mask));
+        EXPECT_EQ((sliced.all_of(mask) & lane) != 0, boards[b].test_all(mask));
+    }
+}
+
+TEST(BitSlicedBoards, Counts)
+{
+    std::mt19937_64 rng{35};
+    auto boards = random_block(rng);
+    boards[0] = BitBoard::make_full();
+    boards[1] = BitBoard{};
+    const auto others = random_block(rng);
+    const BitSlicedBoards sliced{boards};
+    const BitSlicedBoards other_sliced{others};
+
+    const auto counts = sliced.count_planes();
+    const auto greater = sliced.count_greater(other_sliced);
+    const auto at_least = sliced.count_at_least(17);
+    for (std::size_t b = 0; b < 64; ++b) {
+        const auto lane = BitSlicedBoards::lane(b);
+        std::size_t count = 0;
+        for (std::size_t bit = 0; bit < BitSlicedBoards::n_count_planes; ++bit) {
+            count |= ((counts[bit] & lane) != 0 ? std::size_t{1} : 0) << bit;
+        }
+        EXPECT_EQ(count, boards[b].count());
+        EXPECT_EQ((greater & lane) != 0, boards[b].count() > others[b].count());
+        EXPECT_EQ((at_least & lane) != 0, boards[b].count() >= 17);
+    }
+    EXPECT_EQ(sliced.count_at_least(0), ~Bits{0});
+    EXPECT_EQ(sliced.count_at_least(64), BitSlicedBoards::lane(0));
+}
+
+TEST(BitSlicedBoards, PlaneWiseOperators)
+{
+    std::mt19937_64 rng{35};
+    const auto lhs = random_block(rng);
+    const auto rhs = random_block(rng);
+    const auto result = ~(BitSlicedBoards{lhs} & BitSlicedBoards{rhs}) ^ BitSlicedBoards{rhs};
+
+    std::array<BitBoard, 64> boards;
+    result.to_boards(boards);
+    for (std::size_t b = 0; b < 64; ++b) {
+        EXPECT_EQ(boards[b], ~(lhs[b] & rhs[b]) ^ rhs[b]);
+    }
+}
@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "board_pipeline.h"
+#include "bounded_queue.h"
+
+#include <cstddef>
+
+#include <algorithm>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::vector<BitBoard> random_boards(const std::size_t n)
+{
+    std::mt19937_64 rng{34};
+    std::vector<BitBoard> boards;
+    while (boards.size() < n) {
+        boards.emplace_back(rng() & rng());
+    }
+    return boards;
+}
+
+static BoardReader vector_reader(const std::vector<BitBoard>& boards)
+{
+    return [&boards, next = std::size_t{0}](std::span<BitBoard> out) mutable {
+        const auto n = std::min(out.size(), boards.size() - next);
+        std::copy_n(boards.begin() + static_cast<std::ptrdiff_t>(next), n, out.begin());
+        next += n;
+        return n;
+    };
+}
+
+static const std::vector<PipelineStage> analysis_stages{
+    {"canonicalize", canonicalize_batch},
+    {"features", compute_features},
+};
+
+TEST(BoundedQueue, SingleThreaded)
+{
+    BoundedQueue<int> queue{3};
+    EXPECT_EQ(queue.capacity(), 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    int value = 42;
+    EXPECT_FALSE(queue.try_push(value));
+    EXPECT_EQ(queue.size(), 4);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_FALSE(queue.closed());
+    queue.close_producer();
+    EXPECT_TRUE(queue.closed());
+}
+
+TEST(BoundedQueue, ManyProducersManyConsumers)
+{
+    constexpr int n_per_producer = 20000;
+    constexpr unsigned n_producers = 4;
+    BoundedQueue<int> queue{64, n_producers};
+    std::vector<std::thread> threads;
+    for (unsigned producer = 0; producer < n_producers; ++producer) {
+        threads.emplace_back([&queue] {
+            for (int i = 1; i <= n_per_producer; ++i) {
+                int value = i;
+                while (!queue.try_push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+            queue.close_producer();
+        });
+    }
+    std::vector<long long> sums(3, 0);
+    for (auto& sum : sums) {
+        threads.emplace_back([&queue, &sum] {
+            int value = 0;
+            for (;;) {
+                if (queue.try_pop(value)) {
+                    sum += value;
+                } else if (!queue.closed()) {
+                    std::this_thread::yield();
+                } else if (queue.try_pop(value)) {
+                    sum += value;
+                } else {
+                    break;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const long long expected = n_producers * (static_cast<long long>(n_per_producer) * (n_per_producer + 1) / 2);
+    EXPECT_EQ(sums[0] + sums[1] + sums[2], expected);
+}
+
+TEST(BoardPipeline, PreservesOrderAndComputesFeatures)
+{
+    const auto boards = random_boards(100'003);
+    for (const auto execution : {PipelineExecution::thread_per_stage, PipelineExecution::pooled}) {
+        SCOPED_TRACE(static_cast<int>(execution));
+        std::vector<BoardFeatures> written;
+        const PipelineOptions options{1000, 4, execution, 3};
+        const auto stats = run_pipeline(
+            vector_reader(boards),
+            analysis_stages,
+            [&](const BoardBatch& batch) {
+                const auto features = batch.active_features();
+                written.insert(written.end(), features.begin(), features.end());
+            },
+            options
+        );
+
+        ASSERT_EQ(written.size(), boards.size());
+        for (std::size_t i = 0; i < boards.size(); i += 997) {
+            const auto canonical = BitBoard::canonical(boards[i]);
+            EXPECT_EQ(written[i].board, canonical);
+            EXPECT_EQ(written[i].count, boards[i].count());
+            EXPECT_EQ(written[i].on_any_edge, canonical.on_any_edge());
+            EXPECT_EQ(written[i].neighbors, BitBoard::neighbors_cardinal_and_diagonal(canonical) & ~canonical);
+        }
+
+        ASSERT_EQ(stats.stages.size(), 4);
+        EXPECT_EQ(stats.stages[1].name, "canonicalize");
+        EXPECT_EQ(stats.boards, boards.size());
+        for (const auto& stage : stats.stages) {
+            EXPECT_EQ(stage.boards, boards.size());
+            EXPECT_EQ(stage.batches, 101);
+        }
+    }
+}
+
+TEST(BoardPipeline, StreamReaderAndNoTransforms)
+{
+    const auto boards = random_boards(5000);
+    std::stringstream stream;
+    const auto bytes = std::as_bytes(std::span{boards});
+    stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+    std::vector<BitBoard> written;
+    const auto stats = run_pipeline(
+        make_stream_reader(stream),
+        {},
+        [&](const BoardBatch& batch) {
+            const auto active = batch.active_boards();
+            written.insert(written.end(), active.begin(), active.end());
+        },
+        PipelineOptions{1024}
+    );
+    EXPECT_EQ(written, boards);
+    EXPECT_EQ(stats.stages.size(), 2);
+
+    std::ostringstream csv;
+    export_pipeline_stats(csv, stats);
+    EXPECT_EQ(csv.str().rfind("stage,batches,boards,", 0), 0);
+    EXPECT_NE(csv.str().find("\nwrite,5,5000,"), std::string::npos);
+}
+
+TEST(BoardPipeline, StageExceptionPropagates)
+{
+    const auto boards = random_boards(10000);
+    const std::vector<PipelineStage> stages{
+        {"throws", [](BoardBatch& batch) {
+             if (batch.sequence == 3) {
+                 throw std::runtime_error("stage failed");
+             }
+         }},
+    };
+    for (const auto execution : {PipelineExecution::thread_per_stage, PipelineExecution::pooled}) {
+        EXPECT_THROW(
+            static_cast<void>(run_pipeline(
+                vector_reader(boards), stages, [](const BoardBatch&) {}, PipelineOptions{100, 2, execution, 2}
+            )),
+            std::runtime_error
+        );
+    }
+}
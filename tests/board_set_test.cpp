@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "board_set.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <set>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::vector<BitBoard> mixed_boards(std::mt19937_64& rng)
+{
+    std::vector<BitBoard> boards;
+    for (int i = 0; i < 2000; ++i) {
+        boards.emplace_back(rng());
+    }
+    const BitBoard::Bits dense_chunk = rng() & ~BitBoard::Bits{0xffff};
+    for (int i = 0; i < 10000; ++i) {
+        boards.emplace_back(dense_chunk | (rng() & 0xffff));
+    }
+    const BitBoard::Bits run_chunk = (rng() & ~BitBoard::Bits{0xffff}) + 0x10000;
+    for (BitBoard::Bits low = 100; low < 20000; ++low) {
+        boards.emplace_back(run_chunk | low);
+    }
+    for (int i = 0; i < 500; ++i) {
+        boards.emplace_back(rng() & 0xfffff);
+    }
+    return boards;
+}
+
+static std::set<BitBoard> as_std_set(const std::vector<BitBoard>& boards)
+{
+    return {boards.begin(), boards.end()};
+}
+
+TEST(BoardSet, Empty)
+{
+    const BoardSet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(BitBoard{}));
+    EXPECT_EQ(set.rank(BitBoard::make_full()), 0);
+    EXPECT_THROW(static_cast<void>(set.select(0)), std::out_of_range);
+}
+
+TEST(BoardSet, MatchesStdSet)
+{
+    std::mt19937_64 rng{29};
+    const auto boards = mixed_boards(rng);
+    const auto expected = as_std_set(boards);
+    const auto set = BoardSet::from_unsorted(boards);
+
+    ASSERT_EQ(set.size(), expected.size());
+    EXPECT_EQ(set.to_vector(), std::vector<BitBoard>(expected.begin(), expected.end()));
+
+    std::size_t index = 0;
+    for (const auto board : expected) {
+        EXPECT_TRUE(set.contains(board));
+        EXPECT_EQ(set.rank(board), index);
+        EXPECT_EQ(set.select(index), board);
+        ++index;
+    }
+    for (int i = 0; i < 2000; ++i) {
+        const BitBoard probe{rng() & 0x3'ffff'ffff'ffff};
+        EXPECT_EQ(set.contains(probe), expected.contains(probe));
+        const auto below = std::distance(expected.begin(), expected.lower_bound(probe));
+        EXPECT_EQ(set.rank(probe), static_cast<std::size_t>(below));
+    }
+}
+
+TEST(BoardSet, UnionAndIntersection)
+{
+    std::mt19937_64 rng{290};
+    auto lhs_boards = mixed_boards(rng);
+    auto rhs_boards = mixed_boards(rng);
+    rhs_boards.insert(rhs_boards.end(), lhs_boards.begin(), lhs_boards.begin() + 3000);
+    const auto lhs = as_std_set(lhs_boards);
+    const auto rhs = as_std_set(rhs_boards);
+
+    std::vector<BitBoard> expected_union;
+    std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(expected_union));
+    std::vector<BitBoard> expected_intersection;
+    std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(expected_intersection));
+
+    const auto lhs_set = BoardSet::from_unsorted(lhs_boards);
+    const auto rhs_set = BoardSet::from_unsorted(rhs_boards);
+    EXPECT_EQ((lhs_set | rhs_set).to_vector(), expected_union);
+    EXPECT_EQ((lhs_set & rhs_set).to_vector(), expected_intersection);
+    EXPECT_EQ(lhs_set | rhs_set, BoardSet::from_sorted(expected_union));
+}
+
+TEST(BoardSet, SerializedImageRoundTrips)
+{
+    std::mt19937_64 rng{2900};
+    const auto set = BoardSet::from_unsorted(mixed_boards(rng));
+
+    std::ostringstream out;
+    set.write(out);
+    const auto image = out.str();
+    const std::span<const std::byte> bytes{reinterpret_cast<const std::byte*>(image.data()), image.size()};
+
+    const auto view = BoardSetView::from_bytes(bytes);
+    EXPECT_EQ(view.size(), set.size());
+    EXPECT_EQ(view.select(set.size() / 2), set.select(set.size() / 2));
+    EXPECT_EQ(BoardSet::from_bytes(bytes), set);
+
+    EXPECT_THROW(static_cast<void>(BoardSetView::from_bytes(bytes.first(bytes.size() - 1))), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(BoardSetView::from_bytes(bytes.last(16))), std::invalid_argument);
+}
+
+TEST(BoardSet, SparseChunksAreStoredLoose)
+{
+    std::mt19937_64 rng{29000};
+    std::vector<BitBoard> boards;
+    for (int i = 0; i < 1000; ++i) {
+        boards.emplace_back(rng());
+    }
+    const auto set = BoardSet::from_unsorted(boards);
+    EXPECT_EQ(set.view().chunk_count(), 0);
+    EXPECT_EQ(set.view().loose_count(), set.size());
+    EXPECT_EQ(set.bytes().size(), BoardSetView::header_bytes + set.size() * BoardSetView::loose_board_bytes);
+
+    const BitBoard::Bits key = 0x1234'5678'9abc'0000;
+    std::vector<BitBoard> dense;
+    for (BitBoard::Bits low = 0; low < 100; low += 3) {
+        dense.emplace_back(key | low);
+    }
+    const std::vector<BitBoard> sparse{BitBoard{key | 1}, BitBoard{key | 3}, BitBoard{key | 500}};
+    const auto dense_set = BoardSet::from_sorted(dense);
+    const auto sparse_set = BoardSet::from_sorted(sparse);
+    EXPECT_EQ(dense_set.view().chunk_count(), 1);
+    EXPECT_EQ(sparse_set.view().loose_count(), sparse.size());
+
+    std::vector<BitBoard> expected_union;
+    std::set_union(dense.begin(), dense.end(), sparse.begin(), sparse.end(), std::back_inserter(expected_union));
+    EXPECT_EQ(dense_set | sparse_set, BoardSet::from_sorted(expected_union));
+    EXPECT_EQ(sparse_set | dense_set, BoardSet::from_sorted(expected_union));
+    EXPECT_EQ((dense_set & sparse_set).to_vector(), std::vector<BitBoard>{BitBoard{key | 3}});
+    EXPECT_EQ((sparse_set & dense_set).view().loose_count(), 1);
+}
+
+TEST(BoardSet, CorruptImagesAreRejected)
+{
+    std::mt19937_64 rng{290000};
+    const auto set = BoardSet::from_unsorted(mixed_boards(rng));
+    ASSERT_GE(set.view().chunk_count(), 2);
+    ASSERT_GE(set.view().loose_count(), 2);
+    const std::vector<std::byte> image(set.bytes().begin(), set.bytes().end());
+    EXPECT_NO_THROW(static_cast<void>(BoardSetView::from_bytes(image)));
+
+    const auto entry = [](const std::size_t chunk, const std::size_t field) {
+        return BoardSetView::header_bytes + chunk * BoardSetView::chunk_entry_bytes + field * sizeof(std::uint64_t);
+    };
+    const auto loose = BoardSetView::header_bytes + set.view().chunk_count() * BoardSetView::chunk_entry_bytes;
+    const auto rejects = [&](const std::size_t at, const auto change) {
+        auto corrupt = image;
+        std::uint64_t word{};
+        std::memcpy(&word, corrupt.data() + at, sizeof(word));
+        word = change(word);
+        std::memcpy(corrupt.data() + at, &word, sizeof(word));
+        EXPECT_THROW(static_cast<void>(BoardSetView::from_bytes(corrupt)), std::invalid_argument) << "offset " << at;
+    };
+
+    // Keys: out of order, and above 48 bits.
+    rejects(entry(1, 0), [&](const std::uint64_t) {
+        std::uint64_t key{};
+        std::memcpy(&key, image.data() + entry(0, 0), sizeof(key));
+        return key;
+    });
+    rejects(entry(0, 0), [](const std::uint64_t key) { return key | (std::uint64_t{1} << 50); });
+    // Ranks that do not add up.
+    rejects(entry(1, 1), [](const std::uint64_t rank) { return rank + 1; });
+    // Container offset past the data, type out of range, count past a chunk and a zero count.
+    rejects(entry(0, 2), [](const std::uint64_t packed) { return packed | (std::uint64_t{1} << 62); });
+    rejects(entry(0, 2), [](const std::uint64_t packed) { return packed | 3; });
+    rejects(entry(0, 2), [](const std::uint64_t packed) { return packed | (std::uint64_t{0x3fffff} << 2); });
+    rejects(entry(0, 2), [](const std::uint64_t packed) { return packed & ~(std::uint64_t{0x3fffff} << 2); });
+    // Loose boards out of order, and a loose board inside a chunk.
+    rejects(loose, [](const std::uint64_t) { return ~std::uint64_t{0}; });
+    rejects(loose, [&](const std::uint64_t) {
+        std::uint64_t key{};
+        std::memcpy(&key, image.data() + entry(0, 0), sizeof(key));
+        return key << BoardSetView::chunk_bits;
+    });
+    // Total size.
+    rejects(24, [](const std::uint64_t size) { return size - 1; });
+}
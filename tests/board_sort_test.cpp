@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "board_sort.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+static std::vector<BitBoard> random_boards(const std::size_t n, const BitBoard::Bits mask, const unsigned seed)
+{
+    std::mt19937_64 rng{seed};
+    std::vector<BitBoard> boards;
+    for (std::size_t i = 0; i < n; ++i) {
+        boards.emplace_back(rng() & mask);
+    }
+    return boards;
+}
+
+TEST(RadixSort, MatchesStdSort)
+{
+    for (const auto mask : {~BitBoard::Bits{0}, BitBoard::Bits{0xff}, BitBoard::Bits{0x00ff'0000'ff00'0000}}) {
+        auto boards = random_boards(10007, mask, 30);
+        auto expected = boards;
+        std::sort(expected.begin(), expected.end());
+        radix_sort(boards);
+        EXPECT_EQ(boards, expected);
+    }
+}
+
+TEST(RadixSort, EmptyAndSingle)
+{
+    std::vector<BitBoard> boards;
+    radix_sort(boards);
+    EXPECT_TRUE(boards.empty());
+    boards.emplace_back(42);
+    radix_sort(boards);
+    EXPECT_EQ(boards.front(), BitBoard{42});
+}
+
+TEST(SortUnique, MatchesStdSet)
+{
+    for (const unsigned threads : {1U, 3U, 8U}) {
+        const auto boards = random_boards(50000, 0x0000'0f00'00ff'ffff, threads);
+        const std::set<BitBoard> expected{boards.begin(), boards.end()};
+        const auto unique = sort_unique(boards, {threads, false});
+        EXPECT_EQ(unique, std::vector<BitBoard>(expected.begin(), expected.end()));
+    }
+}
+
+TEST(SortUnique, CanonicalizeCollapsesSymmetries)
+{
+    const BitBoard board{0x0000'0000'0010'3804};
+    const std::vector<BitBoard> boards{
+        board,
+        BitBoard::rotate_clockwise(board),
+        BitBoard::flip_vertical(board),
+        BitBoard::flip_diagonal(board),
+        BitBoard::make_full(),
+    };
+    const auto unique = sort_unique(boards, {2, true});
+    EXPECT_EQ(unique, (std::vector<BitBoard>{BitBoard::canonical(board), BitBoard::make_full()}));
+}
+
+TEST(SortUnique, WritesRawWords)
+{
+    const auto boards = random_boards(1000, 0xffff, 31);
+    const auto expected = sort_unique(boards);
+
+    std::ostringstream out;
+    EXPECT_EQ(write_sort_unique(boards, out), expected.size());
+    const auto bytes = out.str();
+    ASSERT_EQ(bytes.size(), expected.size() * sizeof(BitBoard::Bits));
+    std::vector<BitBoard> written(expected.size());
+    std::copy(bytes.begin(), bytes.end(), reinterpret_cast<char*>(written.data()));
+    EXPECT_EQ(written, expected);
+}
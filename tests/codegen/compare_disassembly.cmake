@@ -0,0 +1,18 @@
+# Usage: cmake -DOBJDUMP=<objdump> -DACTUAL=<object> -DEXPECTED=<object> -P compare_disassembly.cmake
+foreach(object ACTUAL EXPECTED)
+    execute_process(
+        COMMAND ${OBJDUMP} -d --no-show-raw-insn ${${object}}
+        OUTPUT_VARIABLE disassembly
+        RESULT_VARIABLE result
+    )
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "failed to disassemble ${${object}}")
+    endif()
+    string(REGEX REPLACE "[^\n]*file format[^\n]*\n" "" disassembly "${disassembly}")
+    set(${object}_DISASSEMBLY "${disassembly}")
+endforeach()
+
+if (NOT ACTUAL_DISASSEMBLY STREQUAL EXPECTED_DISASSEMBLY)
+    message(FATAL_ERROR "generated code differs from reference\n"
+        "--- actual ---\n${ACTUAL_DISASSEMBLY}\n--- expected ---\n${EXPECTED_DISASSEMBLY}")
+endif()
@@ -0,0 +1,49 @@
+# Usage: cmake -DOBJDUMP=<objdump> -DPLAIN=<objects> -DPROBED=<objects> -DFUNCTIONS=<names> -P compare_instrumentation.cmake
+# Objects and function names are separated by '|'. Each named function must call record_probe in the objects
+# built with BITBOARD_INSTRUMENTATION and must not in the objects built without it.
+foreach(list PLAIN PROBED FUNCTIONS)
+    string(REPLACE "|" ";" ${list} "${${list}}")
+endforeach()
+
+foreach(variant PLAIN PROBED)
+    execute_process(
+        COMMAND ${OBJDUMP} -d -r -C --no-show-raw-insn ${${variant}}
+        OUTPUT_VARIABLE disassembly
+        RESULT_VARIABLE result
+    )
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "failed to disassemble ${${variant}}")
+    endif()
+    set(${variant}_DISASSEMBLY "${disassembly}")
+endforeach()
+
+# Sets <out> to the code of the function whose demangled name starts with <name>: from its label to the blank
+# line objdump puts after every function.
+function(function_code out disassembly name)
+    string(FIND "${disassembly}" "<${name}" begin)
+    if (begin EQUAL -1)
+        message(FATAL_ERROR "no function ${name} in the disassembly")
+    endif()
+    string(SUBSTRING "${disassembly}" ${begin} -1 code)
+    string(FIND "${code}" "\n\n" end)
+    string(SUBSTRING "${code}" 0 ${end} code)
+    set(${out} "${code}" PARENT_SCOPE)
+endfunction()
+
+foreach(name ${FUNCTIONS})
+    function_code(plain "${PLAIN_DISASSEMBLY}" "${name}")
+    function_code(probed "${PROBED_DISASSEMBLY}" "${name}")
+    string(FIND "${probed}" "record_probe" probed_call)
+    if (probed_call EQUAL -1)
+        message(FATAL_ERROR "${name} does not record its probe with instrumentation enabled\n${probed}")
+    endif()
+    string(FIND "${plain}" "record_probe" plain_call)
+    if (NOT plain_call EQUAL -1)
+        message(FATAL_ERROR "${name} records a probe with instrumentation disabled\n${plain}")
+    endif()
+    string(REGEX MATCHALL "\n" plain_lines "${plain}")
+    string(REGEX MATCHALL "\n" probed_lines "${probed}")
+    list(LENGTH plain_lines plain_length)
+    list(LENGTH probed_lines probed_length)
+    message(STATUS "${name}: ${plain_length} instructions without probes, ${probed_length} with")
+endforeach()
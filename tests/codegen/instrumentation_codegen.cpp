@@ -0,0 +1,23 @@
+#include "bit_board.h"
+
+#include <cstddef>
+
+#include <string_view>
+
+// Each probed member flattened into a wrapper, so its probe lands in the wrapper's own code whether or not the
+// compiler would have inlined the member. BitBoard::to_string is out of line and checked in bit_board.cpp itself.
+
+[[gnu::flatten]] BitBoard& codegen_shift_assign(BitBoard& board, const Direction direction, const std::size_t n)
+{
+    return board.shift_assign(direction, n);
+}
+
+[[gnu::flatten]] bool codegen_on_any_edge(const BitBoard board)
+{
+    return board.on_any_edge();
+}
+
+[[gnu::flatten]] BitBoard codegen_string_constructor(const std::string_view text)
+{
+    return BitBoard{text};
+}
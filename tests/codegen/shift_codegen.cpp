@@ -0,0 +1,55 @@
+#include "bit_board.h"
+
+// Each compile-time shift must reduce to the single shift-and-mask written out by hand in the reference build.
+#if defined(BITBOARD_CODEGEN_REFERENCE)
+#define CODEGEN_SHIFT(board, D, N, amount, mask) BitBoard{(board.to_ullong() amount) & (mask)}
+#define CODEGEN_OFFSET(board, DX, DY, amount, mask) BitBoard{(board.to_ullong() amount) & (mask)}
+#else
+#define CODEGEN_SHIFT(board, D, N, amount, mask) BitBoard::shift<D, N>(board)
+#define CODEGEN_OFFSET(board, DX, DY, amount, mask) BitBoard::shift(board, Offset<DX, DY>{})
+#endif
+
+BitBoard codegen_shift_right_2(const BitBoard board)
+{
+    return CODEGEN_SHIFT(board, Direction::right, 2, >> 2, 0x3f3f3f3f3f3f3f3fULL);
+}
+
+BitBoard codegen_shift_up_3(const BitBoard board)
+{
+    return CODEGEN_SHIFT(board, Direction::up, 3, << 24, ~0ULL);
+}
+
+BitBoard codegen_shift_downleft_1(const BitBoard board)
+{
+    return CODEGEN_SHIFT(board, Direction::downleft, 1, >> 7, 0xfefefefefefefefeULL);
+}
+
+BitBoard codegen_shift_upright_2(const BitBoard board)
+{
+    return CODEGEN_SHIFT(board, Direction::upright, 2, << 14, 0x3f3f3f3f3f3f3f3fULL);
+}
+
+BitBoard codegen_shift_offset(const BitBoard board)
+{
+    return CODEGEN_OFFSET(board, -1, 2, << 6, 0x3f3f3f3f3f3f3f3fULL);
+}
+
+BitBoard codegen_dilate_left_2(BitBoard board)
+{
+#if defined(BITBOARD_CODEGEN_REFERENCE)
+    board |= BitBoard{(board.to_ullong() << 1) & 0xfefefefefefefefeULL};
+    board |= BitBoard{(board.to_ullong() << 1) & 0xfefefefefefefefeULL};
+    return board;
+#else
+    return board.dilate<Direction::left, 2>();
+#endif
+}
+
+BitBoard codegen_make_column_3()
+{
+#if defined(BITBOARD_CODEGEN_REFERENCE)
+    return BitBoard{0x1010101010101010ULL};
+#else
+    return BitBoard::make_column<3>();
+#endif
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "evaluation.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+template <typename Weight>
+static std::array<Weight, BitBoard::n_bits> random_weights(std::mt19937_64& rng)
+{
+    std::uniform_int_distribution<int> distribution{
+        std::numeric_limits<Weight>::min(), std::numeric_limits<Weight>::max()};
+    std::array<Weight, BitBoard::n_bits> weights{};
+    for (auto& weight : weights) {
+        weight = static_cast<Weight>(distribution(rng));
+    }
+    return weights;
+}
+
+template <typename Weight>
+static Score evaluate_naive(const SquareWeights<Weight>& weights, const BitBoard board)
+{
+    Score score = 0;
+    for (const auto& position : board.to_position_vector()) {
+        score += weights[position];
+    }
+    return score;
+}
+
+template <typename Weight>
+class SquareWeightsTest : public ::testing::Test
+{};
+
+using WeightTypes = ::testing::Types<std::int8_t, std::int16_t>;
+TYPED_TEST_SUITE(SquareWeightsTest, WeightTypes);
+
+TYPED_TEST(SquareWeightsTest, SingleSquare)
+{
+    std::array<TypeParam, BitBoard::n_bits> values{};
+    values[4 * BitBoard::board_size + 2] = -7;
+    values[0] = 3;
+    const SquareWeights<TypeParam> weights{values};
+
+    EXPECT_EQ(weights.evaluate(BitBoard{BitBoard::Position{4, 2}}), -7);
+    EXPECT_EQ(weights.evaluate(BitBoard::make_top_left()), 3);
+    EXPECT_EQ(weights.evaluate_bit_sliced(BitBoard::make_top_left() | BitBoard{BitBoard::Position{4, 2}}), -4);
+    EXPECT_EQ(weights.evaluate(BitBoard{}), 0);
+}
+
+TYPED_TEST(SquareWeightsTest, MatchesNaive)
+{
+    std::mt19937_64 rng{26};
+    const SquareWeights<TypeParam> weights{random_weights<TypeParam>(rng)};
+
+    std::vector<BitBoard> boards{BitBoard{}, BitBoard::make_full(), BitBoard::make_all_edge()};
+    for (int i = 0; i < 1000; ++i) {
+        boards.emplace_back(rng() & rng());
+    }
+    std::vector<Score> scores(boards.size());
+    weights.evaluate(boards, scores);
+
+    for (std::size_t i = 0; i < boards.size(); ++i) {
+        const auto expected = evaluate_naive(weights, boards[i]);
+        EXPECT_EQ(weights.evaluate(boards[i]), expected);
+        EXPECT_EQ(weights.evaluate_bit_sliced(boards[i]), expected);
+        EXPECT_EQ(scores[i], expected);
+    }
+}
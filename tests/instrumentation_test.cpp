@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "instrumentation.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+static std::uint64_t calls(const InstrumentationSnapshot& snapshot, const Probe probe)
+{
+    return snapshot[static_cast<std::size_t>(probe)].calls;
+}
+
+TEST(Instrumentation, CountsEntryPoints)
+{
+    reset_instrumentation();
+    BitBoard board{std::string(BitBoard::n_bits, '1')};
+    board.shift_assign(Direction::left, 2);
+    static_cast<void>(board.to_position_set());
+    EXPECT_THROW(BitBoard(BitBoard::Position{8, 0}), std::invalid_argument);
+    std::thread{[] { static_cast<void>(BitBoard{}.to_string()); }}.join();
+
+    const auto snapshot = instrumentation_snapshot();
+    const std::uint64_t expected = instrumentation_enabled() ? 1 : 0;
+    EXPECT_EQ(calls(snapshot, Probe::string_constructor), expected);
+    EXPECT_EQ(calls(snapshot, Probe::shift_dynamic), expected);
+    EXPECT_EQ(calls(snapshot, Probe::to_position_set), expected);
+    EXPECT_EQ(calls(snapshot, Probe::from_position_error), expected);
+    EXPECT_EQ(calls(snapshot, Probe::to_string), expected);
+    EXPECT_EQ(calls(snapshot, Probe::neighbors), 0);
+}
+
+TEST(Instrumentation, ExportsOneLinePerProbe)
+{
+    std::ostringstream out;
+    export_instrumentation(out, instrumentation_snapshot());
+    const auto text = out.str();
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'), n_probes + 1);
+    EXPECT_NE(text.find("shift_dynamic,"), std::string::npos);
+}
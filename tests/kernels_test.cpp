@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "evaluation.h"
+#include "kernels.h"
+#include "move_list.h"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+static std::vector<CpuLevel> supported_levels()
+{
+    std::vector<CpuLevel> levels;
+    for (auto level = CpuLevel::generic; level <= detected_cpu_level();
+         level = static_cast<CpuLevel>(static_cast<int>(level) + 1)) {
+        levels.push_back(level);
+    }
+    return levels;
+}
+
+static std::vector<BitBoard> random_boards(const std::size_t n)
+{
+    std::mt19937_64 rng{27};
+    std::vector<BitBoard> boards{BitBoard{}, BitBoard::make_full()};
+    while (boards.size() < n) {
+        boards.emplace_back(rng() & rng());
+    }
+    return boards;
+}
+
+TEST(CpuLevel, NamesRoundTrip)
+{
+    for (const auto level : {CpuLevel::generic, CpuLevel::popcnt, CpuLevel::bmi2, CpuLevel::avx2, CpuLevel::avx512}) {
+        EXPECT_EQ(cpu_level_from_string(to_string(level)), level);
+    }
+    EXPECT_FALSE(cpu_level_from_string("sse9").has_value());
+}
+
+TEST(CpuLevel, ForceIsClampedToDetected)
+{
+    force_cpu_level(CpuLevel::avx512);
+    EXPECT_EQ(cpu_level(), detected_cpu_level());
+    EXPECT_EQ(kernels().level, kernels_for(cpu_level()).level);
+
+    force_cpu_level(CpuLevel::generic);
+    EXPECT_EQ(cpu_level(), CpuLevel::generic);
+    EXPECT_EQ(kernels().level, CpuLevel::generic);
+    reset_cpu_level();
+}
+
+TEST(Kernels, AllLevelsAgree)
+{
+    const auto boards = random_boards(1003);
+    const auto& reference = kernels_for(CpuLevel::generic);
+    std::vector<std::uint8_t> expected_counts(boards.size());
+    reference.count_each(boards, expected_counts);
+
+    for (const auto level : supported_levels()) {
+        SCOPED_TRACE(to_string(level));
+        const auto& candidate = kernels_for(level);
+
+        EXPECT_EQ(candidate.count_total(boards), reference.count_total(boards));
+
+        std::vector<std::uint8_t> counts(boards.size());
+        candidate.count_each(boards, counts);
+        EXPECT_EQ(counts, expected_counts);
+
+        for (std::size_t i = 0; i + 1 < boards.size(); ++i) {
+            const auto bits = boards[i].to_ullong();
+            const auto mask = boards[i + 1].to_ullong();
+            EXPECT_EQ(candidate.extract_bits(bits, mask), reference.extract_bits(bits, mask));
+            EXPECT_EQ(candidate.deposit_bits(bits, mask), reference.deposit_bits(bits, mask));
+            for (std::size_t n = 0; n <= BitBoard::n_bits; n += 7) {
+                EXPECT_EQ(candidate.select_bit(bits, n), reference.select_bit(bits, n));
+            }
+
+            std::array<std::uint8_t, BitBoard::n_bits> indices{};
+            std::array<std::uint8_t, BitBoard::n_bits> expected_indices{};
+            const auto n = candidate.square_indices(boards[i], indices);
+            ASSERT_EQ(n, reference.square_indices(boards[i], expected_indices));
+            EXPECT_TRUE(std::equal(indices.begin(), indices.begin() + n, expected_indices.begin()));
+
+            std::array<Move, BitBoard::n_bits> moves;
+            std::array<Move, BitBoard::n_bits> expected_moves;
+            const Move base{i % BitBoard::n_bits, 0, static_cast<unsigned>(i % 16)};
+            const auto n_moves = candidate.serialize_moves(base, bits, moves);
+            ASSERT_EQ(n_moves, reference.serialize_moves(base, bits, expected_moves));
+            EXPECT_TRUE(std::equal(moves.begin(), moves.begin() + n_moves, expected_moves.begin()));
+        }
+    }
+}
+
+TEST(Kernels, SoftwareBitManipulation)
+{
+    const auto& generic = kernels_for(CpuLevel::generic);
+    EXPECT_EQ(generic.extract_bits(0b1011'0110, 0b1111'0000), 0b1011U);
+    EXPECT_EQ(generic.deposit_bits(0b101, 0b1101'0000), 0b1001'0000U);
+    EXPECT_EQ(generic.select_bit(0b1011'0110, 0), 0b10U);
+    EXPECT_EQ(generic.select_bit(0b1011'0110, 4), 0b1000'0000U);
+    EXPECT_EQ(generic.select_bit(0b1011'0110, 5), 0U);
+    EXPECT_EQ(generic.select_bit(~BitBoard::Bits{0}, 63), BitBoard::Bits{1} << 63);
+    for (std::size_t n = 0; n < 64; ++n) {
+        const auto bits = 0xf0f0'0000'ffff'0101 | (BitBoard::Bits{1} << n);
+        const auto expected = generic.deposit_bits(BitBoard::Bits{1} << (n % 16), bits);
+        EXPECT_EQ(generic.select_bit(bits, n % 16), expected);
+    }
+}
+
+TEST(Kernels, EvaluateAllLevels)
+{
+    std::mt19937_64 rng{270};
+    std::array<std::int16_t, BitBoard::n_bits> values{};
+    for (auto& value : values) {
+        value = static_cast<std::int16_t>(rng());
+    }
+    const SquareWeights<std::int16_t> weights{values};
+    const auto boards = random_boards(37);
+
+    for (const auto level : supported_levels()) {
+        SCOPED_TRACE(to_string(level));
+        std::vector<Score> scores(boards.size());
+        kernels_for(level).evaluate_bit_planes(weights.bit_planes(), boards, scores);
+        for (std::size_t i = 0; i < boards.size(); ++i) {
+            EXPECT_EQ(scores[i], weights.evaluate(boards[i]));
+        }
+    }
+}
@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "leaper_attacks.h"
+
+#include <array>
+#include <random>
+#include <span>
+#include <vector>
+
+using Position = BitBoard::Position;
+
+// Square by square with the runtime Position shift, the way callers had to do it before.
+static BitBoard naive_leaper_attacks(const BitBoard pieces, const int dx, const int dy)
+{
+    const std::array<Position, 8> offsets{
+        Position{dx, dy},
+        Position{dx, -dy},
+        Position{-dx, dy},
+        Position{-dx, -dy},
+        Position{dy, dx},
+        Position{dy, -dx},
+        Position{-dy, dx},
+        Position{-dy, -dx},
+    };
+    BitBoard attacks{};
+    for (const auto& piece : pieces.to_bitboard_vector()) {
+        for (const auto& offset : offsets) {
+            attacks |= BitBoard::shift(piece, offset);
+        }
+    }
+    return attacks;
+}
+
+static std::vector<BitBoard> random_boards()
+{
+    std::mt19937_64 rng{41};
+    std::vector<BitBoard> boards{BitBoard::make_full(), BitBoard::make_all_edge(), BitBoard::make_top_left()};
+    for (int i = 0; i < 200; ++i) {
+        boards.emplace_back(i % 2 == 0 ? rng() & rng() & rng() : rng());
+    }
+    return boards;
+}
+
+TEST(LeaperAttacks, KnightFromSingleSquares)
+{
+    EXPECT_EQ(knight_attacks(BitBoard(Position(0, 0))), BitBoard(Position(1, 2)) | BitBoard(Position(2, 1)));
+    EXPECT_EQ(knight_attacks(BitBoard(Position(3, 4))).count(), 8);
+    EXPECT_EQ(knight_attacks(BitBoard(Position(7, 6))).count(), 3);
+    EXPECT_EQ(camel_attacks(BitBoard(Position(0, 0))), BitBoard(Position(1, 3)) | BitBoard(Position(3, 1)));
+    EXPECT_EQ(zebra_attacks(BitBoard(Position(5, 5))).count(), 4);
+}
+
+TEST(LeaperAttacks, MatchesPerSquareShifts)
+{
+    for (const auto board : random_boards()) {
+        ASSERT_EQ(knight_attacks(board), naive_leaper_attacks(board, 1, 2));
+        ASSERT_EQ(camel_attacks(board), naive_leaper_attacks(board, 1, 3));
+        ASSERT_EQ(zebra_attacks(board), naive_leaper_attacks(board, 2, 3));
+        ASSERT_EQ((leaper_attacks<0, 1>(board)), BitBoard::neighbors_cardinal(board));
+        ASSERT_EQ((leaper_attacks<1, 1>(board)), BitBoard::neighbors_diagonal(board));
+        ASSERT_EQ((leaper_attacks<3, 4>(board)), naive_leaper_attacks(board, 3, 4));
+    }
+}
+
+TEST(LeaperAttacks, RuntimeStepsMatchCompileTimeOffsets)
+{
+    for (const auto board : random_boards()) {
+        for (int dx = 0; dx < BitBoard::board_size; ++dx) {
+            for (int dy = 0; dy < BitBoard::board_size; ++dy) {
+                ASSERT_EQ(leaper_attacks(board, dx, dy), naive_leaper_attacks(board, dx, dy)) << dx << ", " << dy;
+            }
+        }
+        const std::array steps{LeaperStep{Position{2, 0}}, LeaperStep{Position{-1, 5}}};
+        ASSERT_EQ(
+            leaper_attacks(board, steps),
+            BitBoard::shift(board, Offset<2, 0>{}) | BitBoard::shift(board, Offset<-1, 5>{})
+        );
+    }
+    EXPECT_TRUE(leaper_attacks(BitBoard::make_full(), std::span<const LeaperStep>{}).empty());
+    EXPECT_TRUE(leaper_attacks(BitBoard::make_full(), 8, 8).empty());
+    EXPECT_TRUE(LeaperStep{Position(0, -100)}.apply(BitBoard::make_full()).empty());
+}
+
+TEST(PawnMoves, PushesAndDoublePushes)
+{
+    const BitBoard white{"00000000"
+                         "00000000"
+                         "00000000"
+                         "00000000"
+                         "00000000"
+                         "00000001"
+                         "11100010"
+                         "00000000"};
+    const BitBoard blockers{"00000000"
+                            "00000000"
+                            "00000000"
+                            "00000000"
+                            "00100000"
+                            "01000000"
+                            "00000000"
+                            "00000000"};
+    const auto empty = ~(white | blockers);
+    EXPECT_EQ(
+        pawn_pushes<Direction::up>(white, empty),
+        BitBoard{"00000000"
+                 "00000000"
+                 "00000000"
+                 "00000000"
+                 "00000001"
+                 "10100010"
+                 "00000000"
+                 "00000000"}
+    );
+    EXPECT_EQ(
+        pawn_double_pushes<Direction::up>(white, empty),
+        BitBoard{"00000000"
+                 "00000000"
+                 "00000000"
+                 "00000000"
+                 "10000010"
+                 "00000000"
+                 "00000000"
+                 "00000000"}
+    );
+    const auto black = BitBoard::flip_vertical(white);
+    const auto black_empty = BitBoard::flip_vertical(empty);
+    EXPECT_EQ(
+        pawn_pushes<Direction::down>(black, black_empty),
+        BitBoard::flip_vertical(pawn_pushes<Direction::up>(white, empty))
+    );
+    EXPECT_EQ(
+        pawn_double_pushes<Direction::down>(black, black_empty),
+        BitBoard::flip_vertical(pawn_double_pushes<Direction::up>(white, empty))
+    );
+}
+
+TEST(PawnMoves, Captures)
+{
+    const BitBoard pawns{Position{6, 0}};
+    EXPECT_EQ(pawn_attacks<Direction::up>(pawns), BitBoard(Position(5, 1)));
+    EXPECT_EQ(pawn_attacks<Direction::down>(BitBoard(Position(1, 7))), BitBoard(Position(2, 6)));
+    EXPECT_EQ(pawn_attacks<Direction::up>(BitBoard(Position(4, 4))), BitBoard(Position(3, 3)) | BitBoard(Position(3, 5)));
+    EXPECT_EQ(pawn_captures<Direction::up>(pawns, BitBoard::make_full()), BitBoard(Position(5, 1)));
+    EXPECT_TRUE(pawn_captures<Direction::up>(pawns, ~BitBoard(Position(5, 1))).empty());
+}
+
+namespace constexpr_checks {
+
+static_assert(knight_attacks(BitBoard::make_top_left()).count() == 2);
+static_assert(
+    leaper_attacks<2, 2>(BitBoard::make_bottom_right()) ==
+    BitBoard::shift<Direction::upleft, 2>(BitBoard::make_bottom_right())
+);
+
+} // namespace constexpr_checks
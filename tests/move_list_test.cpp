@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "leaper_attacks.h"
+#include "move_list.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using Position = BitBoard::Position;
+
+TEST(Move, PacksSquaresAndFlags)
+{
+    const Move move{9, 63, 5};
+    EXPECT_EQ(move.from(), 9U);
+    EXPECT_EQ(move.to(), 63U);
+    EXPECT_EQ(move.flags(), 5U);
+    EXPECT_EQ(move.bits(), 9 | (63 << 6) | (5 << 12));
+    EXPECT_EQ(move.from_position(), Position(1, 1));
+    EXPECT_EQ(move.to_position(), Position(7, 7));
+    EXPECT_EQ(Move{move.bits()}, move);
+}
+
+TEST(MoveList, IsAlignedAndFixedSize)
+{
+    EXPECT_EQ(alignof(MoveList<>), 64U);
+    EXPECT_EQ(MoveList<>::capacity(), 256U);
+    MoveList<> moves;
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(moves.data()) % 64, 0U);
+    EXPECT_TRUE(moves.empty());
+}
+
+TEST(MoveList, MatchesNestedBoardLoops)
+{
+    std::mt19937_64 rng{42};
+    for (int i = 0; i < 200; ++i) {
+        const BitBoard knights{rng() & rng() & rng()};
+        const auto occupied = BitBoard{rng()} | knights;
+
+        MoveList<> moves;
+        std::vector<Move> expected;
+        for (const auto& knight : knights.to_bitboard_vector()) {
+            const auto from = knight.to_position();
+            const auto from_square = static_cast<std::size_t>(from.x() * BitBoard::board_size + from.y());
+            const auto targets = knight_attacks(knight) & ~occupied;
+            moves.add_moves(from_square, targets, 3);
+            // serialize_moves writes the least significant bit, i.e. the highest square, first.
+            auto squares = targets.to_position_vector();
+            std::sort(squares.begin(), squares.end(), [](const Position& lhs, const Position& rhs) {
+                return std::pair{lhs.x(), lhs.y()} > std::pair{rhs.x(), rhs.y()};
+            });
+            for (const auto& to : squares) {
+                expected.emplace_back(from_square, static_cast<std::size_t>(to.x() * BitBoard::board_size + to.y()), 3);
+            }
+        }
+        ASSERT_EQ(moves.size(), expected.size());
+        EXPECT_TRUE(std::equal(moves.begin(), moves.end(), expected.begin()));
+    }
+}
+
+TEST(MoveList, FullBoardAndOverflow)
+{
+    MoveList<128> moves;
+    moves.add_moves(0, BitBoard::make_full());
+    moves.add_moves(63, BitBoard::make_full());
+    ASSERT_EQ(moves.size(), 128U);
+    EXPECT_EQ(moves[0], Move(0, 63));
+    EXPECT_EQ(moves[63], Move(0, 0));
+    EXPECT_EQ(moves[64], Move(63, 63));
+    EXPECT_THROW(moves.add_moves(1, BitBoard::make_top_left()), std::length_error);
+    EXPECT_THROW(moves.push_back(Move{1, 2}), std::length_error);
+    moves.clear();
+    moves.add_moves(1, BitBoard{});
+    EXPECT_TRUE(moves.empty());
+}
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "neighbor_counts.h"
+
+#include <cstddef>
+
+#include <random>
+
+using Position = BitBoard::Position;
+
+static constexpr BitBoard corners{0x8100000000000081ULL};
+
+static std::size_t naive_window_count(const BitBoard board, const Position& center, const int radius)
+{
+    std::size_t count = 0;
+    for (int dx = -radius; dx <= radius; ++dx) {
+        for (int dy = -radius; dy <= radius; ++dy) {
+            const int x = center.x() + dx;
+            const int y = center.y() + dy;
+            if ((dx != 0 || dy != 0) && x >= 0 && x < 8 && y >= 0 && y < 8 && board.test(Position{x, y})) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+TEST(NeighborCounts, MatchesPerSquareCount)
+{
+    std::mt19937_64 rng{36};
+    for (int i = 0; i < 500; ++i) {
+        const BitBoard board{i % 2 == 0 ? rng() : rng() | rng()};
+        const auto counts = neighbor_counts(board);
+        const auto wide_counts = neighbor_counts_5x5(board);
+        for (int x = 0; x < 8; ++x) {
+            for (int y = 0; y < 8; ++y) {
+                const Position position{x, y};
+                const auto expected = (BitBoard::neighbors_cardinal_and_diagonal(position) & board).count();
+                ASSERT_EQ(count_at(counts, position), expected);
+                ASSERT_EQ(count_at(counts, position), naive_window_count(board, position, 1));
+                ASSERT_EQ(count_at(wide_counts, position), naive_window_count(board, position, 2));
+            }
+        }
+    }
+}
+
+TEST(NeighborCounts, FullBoard)
+{
+    const auto counts = neighbor_counts(BitBoard::make_full());
+    EXPECT_EQ(count_equal(counts, 8), BitBoard::make_full() & ~BitBoard::make_all_edge());
+    EXPECT_EQ(count_equal(counts, 3), corners);
+    EXPECT_EQ(count_equal(counts, 5), BitBoard::make_all_edge() & ~corners);
+
+    const auto wide_counts = neighbor_counts_5x5(BitBoard::make_full());
+    EXPECT_EQ(count_equal(wide_counts, 24).count(), 16);
+    EXPECT_EQ(count_equal(wide_counts, 8), corners);
+}
+
+TEST(NeighborCounts, Thresholds)
+{
+    std::mt19937_64 rng{36};
+    for (int i = 0; i < 100; ++i) {
+        const BitBoard board{rng()};
+        const auto counts = neighbor_counts(board);
+        EXPECT_EQ(count_at_least(counts, 0), BitBoard::make_full());
+        EXPECT_EQ(count_at_least(counts, 16), BitBoard{});
+        EXPECT_EQ(count_equal(counts, 16), BitBoard{});
+        for (std::size_t k = 0; k <= 9; ++k) {
+            BitBoard expected{};
+            for (int x = 0; x < 8; ++x) {
+                for (int y = 0; y < 8; ++y) {
+                    if (count_at(counts, Position{x, y}) >= k) {
+                        expected.set(Position{x, y});
+                    }
+                }
+            }
+            EXPECT_EQ(count_at_least(counts, k), expected);
+            EXPECT_EQ(count_at_least(counts, k) & ~count_at_least(counts, k + 1), count_equal(counts, k));
+        }
+    }
+}
+
+TEST(NeighborCounts, Constexpr)
+{
+    constexpr auto counts = neighbor_counts(corners);
+    static_assert(count_at(counts, Position{1, 1}) == 1);
+    static_assert(count_equal(counts, 0).count() == 52);
+    static_assert(count_at_least(add_board(counts, corners), 2) == BitBoard{});
+}
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "playout.h"
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+TEST(Playout, SelectNthSetBitMatchesSquareOrder)
+{
+    std::mt19937_64 rng{38};
+    for (int i = 0; i < 200; ++i) {
+        const BitBoard board{rng() & rng()};
+        const auto squares = board.to_bitboard_vector();
+        for (std::size_t n = 0; n < squares.size(); ++n) {
+            ASSERT_EQ(select_nth_set_bit(board, n), squares[n]);
+        }
+        EXPECT_EQ(select_nth_set_bit(board, squares.size()), BitBoard{});
+    }
+    EXPECT_EQ(select_nth_set_bit(BitBoard{}, 0), BitBoard{});
+    EXPECT_EQ(select_nth_set_bit(BitBoard::make_full(), 0), BitBoard::make_top_left());
+    EXPECT_EQ(select_nth_set_bit(BitBoard::make_full(), 63), BitBoard::make_bottom_right());
+}
+
+TEST(Playout, RandomSetBitIsUniform)
+{
+    Xoshiro256 rng{38};
+    const BitBoard board{0x8100'0000'1800'0081};
+    std::array<int, BitBoard::n_bits> hits{};
+    constexpr int draws = 60000;
+    for (int i = 0; i < draws; ++i) {
+        const auto square = random_set_bit(board, rng);
+        ASSERT_TRUE(square.has_single_position());
+        ASSERT_TRUE(board.test_all(square));
+        ++hits[static_cast<std::size_t>(std::countl_zero(square.to_ullong()))];
+    }
+    for (std::size_t index = 0; index < hits.size(); ++index) {
+        if (board.test_any(BitBoard{BitBoard::Bits{1} << (63 - index)})) {
+            EXPECT_NEAR(hits[index], draws / 6, draws / 60);
+        } else {
+            EXPECT_EQ(hits[index], 0);
+        }
+    }
+    EXPECT_EQ(random_set_bit(BitBoard{}, rng), BitBoard{});
+}
+
+TEST(Playout, XoshiroStreams)
+{
+    Xoshiro256 a{1};
+    Xoshiro256 b{1};
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a(), b());
+    b.jump();
+    EXPECT_NE(a, b);
+    EXPECT_NE(Xoshiro256{1}(), Xoshiro256{2}());
+}
+
+TEST(Playout, FourInARow)
+{
+    const BitBoard row{"11110000"
+                       "00000000"
+                       "00000000"
+                       "00000000"
+                       "00000000"
+                       "00000000"
+                       "00000000"
+                       "00000000"};
+    EXPECT_TRUE(FourInARow::has_four(row));
+    const BitBoard wrapped{"00000111"
+                           "10000000"
+                           "00000000"
+                           "00000000"
+                           "00000000"
+                           "00000000"
+                           "00000000"
+                           "00000000"};
+    EXPECT_FALSE(FourInARow::has_four(wrapped));
+    EXPECT_TRUE(FourInARow::has_four(BitBoard::flip_diagonal(row)));
+    BitBoard anti_diagonal{"00000000"
+                                 "00010000"
+                                 "00100000"
+                                 "01000000"
+                                 "10000000"
+                                 "00000000"
+                                 "00000000"
+                                 "00000000"};
+    EXPECT_TRUE(FourInARow::has_four(anti_diagonal));
+    anti_diagonal.clear(BitBoard::Position{4, 0});
+    EXPECT_FALSE(FourInARow::has_four(anti_diagonal));
+
+    const FourInARow game;
+    const FourInARow::State won{BitBoard{}, row};
+    EXPECT_TRUE(game.moves(won).empty());
+    EXPECT_EQ(game.score(won), -1);
+}
+
+TEST(Playout, DriverPlaysToTheEnd)
+{
+    const FourInARow game;
+    const FourInARow::State start{BitBoard{}, BitBoard{}};
+    PlayoutDriver driver{game, 38};
+    for (int i = 0; i < 100; ++i) {
+        const auto result = driver.run(start);
+        EXPECT_GE(result.plies, 7);
+        EXPECT_LE(result.plies, BitBoard::n_bits);
+        if (result.score != 0) {
+            // The side that moved last won: the first player on odd plies.
+            EXPECT_EQ(result.score, result.plies % 2 == 1 ? 1 : -1);
+        }
+    }
+    const auto stats = driver.run_batch(start, 500);
+    EXPECT_EQ(stats.playouts, 500);
+    EXPECT_EQ(stats.wins + stats.draws + stats.losses, 500);
+    EXPECT_GT(stats.wins, stats.losses);
+
+    EXPECT_EQ(driver.run(start, 3).plies, 3);
+}
+
+TEST(Playout, ParallelIsDeterministic)
+{
+    const FourInARow game;
+    const FourInARow::State start{BitBoard{}, BitBoard{}};
+    const auto first = run_parallel_playouts(game, start, 2001, 4, 38);
+    const auto second = run_parallel_playouts(game, start, 2001, 4, 38);
+    EXPECT_EQ(first.playouts, 2001);
+    EXPECT_EQ(first.wins, second.wins);
+    EXPECT_EQ(first.plies, second.plies);
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "kernels.h"
+#include "leaper_attacks.h"
+#include "reachability.h"
+
+#include <cstddef>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using Position = BitBoard::Position;
+
+// A single winding path from the top left to the bottom left, 36 squares long.
+static const BitBoard maze{"11111111"
+                           "00000001"
+                           "11111111"
+                           "10000000"
+                           "11111111"
+                           "00000001"
+                           "11111111"
+                           "10000000"};
+
+TEST(Reachability, WithinSteps)
+{
+    const auto full = BitBoard::make_full();
+    const BitBoard corner{Position(0, 0)};
+    EXPECT_EQ(reachable_within(corner, full, 0, Neighborhood::cardinal_and_diagonal), corner);
+    EXPECT_EQ(reachable_within(corner, full, 2, Neighborhood::cardinal_and_diagonal).count(), 9U);
+    EXPECT_EQ(reachable_within(corner, full, 2, Neighborhood::cardinal).count(), 6U);
+    EXPECT_EQ(reachable_within(corner, full, 100, Neighborhood::diagonal).count(), 32U);
+}
+
+TEST(Reachability, StopsAtFixpoint)
+{
+    const auto result = reach(ReachQuery{BitBoard{Position(0, 0)}, maze, BitBoard{}}, Neighborhood::cardinal);
+    EXPECT_FALSE(result.hit);
+    EXPECT_EQ(result.reached, maze);
+    EXPECT_EQ(result.steps, maze.count() - 1);
+}
+
+TEST(Reachability, StopsAtTarget)
+{
+    const ReachQuery query{BitBoard{Position(0, 0)}, maze, BitBoard{Position(1, 7)} | BitBoard{Position(7, 0)}};
+    const auto result = reach(query, Neighborhood::cardinal);
+    EXPECT_TRUE(result.hit);
+    EXPECT_EQ(result.steps, 8U);
+    EXPECT_FALSE(result.reached.test(Position(2, 7)));
+
+    EXPECT_TRUE(connected(Position(0, 0), Position(7, 0), maze, Neighborhood::cardinal));
+    EXPECT_FALSE(connected(Position(0, 0), Position(7, 0), maze & ~BitBoard{Position(3, 0)}, Neighborhood::cardinal));
+    EXPECT_TRUE(connected(Position(4, 4), Position(4, 4), BitBoard{}, Neighborhood::cardinal));
+}
+
+TEST(Reachability, CustomMoves)
+{
+    const ReachQuery query{BitBoard::make_top_left(), BitBoard::make_full(), BitBoard::make_bottom_right()};
+    const auto result = reach(query, [](const BitBoard frontier) { return knight_attacks(frontier); });
+    EXPECT_TRUE(result.hit);
+    EXPECT_EQ(result.steps, 6U);
+}
+
+static std::vector<ReachQuery> random_queries(const std::size_t n)
+{
+    std::mt19937_64 rng{43};
+    std::vector<ReachQuery> queries;
+    while (queries.size() < n) {
+        const BitBoard source{BitBoard::Bits{1} << (rng() % BitBoard::n_bits)};
+        const BitBoard allowed{rng() | rng()};
+        const BitBoard targets{queries.size() % 3 == 0 ? 0 : rng() & rng() & rng() & rng()};
+        queries.push_back({source, allowed, targets, static_cast<std::size_t>(rng() % 20)});
+    }
+    queries.push_back({BitBoard{}, BitBoard::make_full(), BitBoard::make_full()});
+    queries.push_back({BitBoard::make_full(), BitBoard::make_full(), BitBoard{}});
+    queries.push_back({BitBoard::make_top_left(), BitBoard::make_full(), BitBoard{}, static_cast<std::size_t>(-1)});
+    return queries;
+}
+
+TEST(Reachability, BatchMatchesSingleQueries)
+{
+    const auto queries = random_queries(1001);
+    for (auto level = CpuLevel::generic; level <= detected_cpu_level();
+         level = static_cast<CpuLevel>(static_cast<int>(level) + 1)) {
+        SCOPED_TRACE(to_string(level));
+        for (const auto neighborhood :
+             {Neighborhood::cardinal, Neighborhood::diagonal, Neighborhood::cardinal_and_diagonal}) {
+            std::vector<ReachResult> results(queries.size());
+            kernels_for(level).reach_batch(queries, results, neighborhood);
+            for (std::size_t i = 0; i < queries.size(); ++i) {
+                ASSERT_EQ(results[i], reach(queries[i], neighborhood)) << i;
+            }
+        }
+    }
+    std::vector<ReachResult> too_few(queries.size() - 1);
+    EXPECT_THROW(reach_batch(queries, too_few, Neighborhood::cardinal), std::invalid_argument);
+}
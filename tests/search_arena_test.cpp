@@ -0,0 +1,199 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "search_arena.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+std::atomic<std::size_t> n_allocations{0};
+
+void* counted_allocate(const std::size_t size)
+{
+    n_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* counted_allocate(const std::size_t size, const std::align_val_t alignment)
+{
+    n_allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+class AllocationCounter
+{
+  public:
+    AllocationCounter() noexcept : start_(n_allocations.load()) {}
+
+    [[nodiscard]] std::size_t count() const noexcept
+    {
+        return n_allocations.load() - start_;
+    }
+
+  private:
+    std::size_t start_;
+};
+} // namespace
+
+void* operator new(const std::size_t size)
+{
+    return counted_allocate(size);
+}
+void* operator new[](const std::size_t size)
+{
+    return counted_allocate(size);
+}
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    return counted_allocate(size, alignment);
+}
+void* operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+    return counted_allocate(size, alignment);
+}
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+static const BitBoard test_board{"10000001"
+                                 "01000010"
+                                 "00100100"
+                                 "00011000"
+                                 "00011000"
+                                 "00100100"
+                                 "01000010"
+                                 "10000001"};
+
+TEST(SearchArena, ResourceOverloadsMatchAllocatingForms)
+{
+    SearchArena arena{1024};
+    const auto positions = test_board.to_position_vector(&arena);
+    const auto boards = test_board.to_bitboard_vector(&arena);
+    const auto position_set = test_board.to_position_set(&arena);
+    const auto str = test_board.to_string(&arena);
+
+    const auto expected_positions = test_board.to_position_vector();
+    const auto expected_boards = test_board.to_bitboard_vector();
+    const auto expected_set = test_board.to_position_set();
+    EXPECT_TRUE(std::equal(positions.begin(), positions.end(), expected_positions.begin(), expected_positions.end()));
+    EXPECT_TRUE(std::equal(boards.begin(), boards.end(), expected_boards.begin(), expected_boards.end()));
+    EXPECT_TRUE(std::equal(position_set.begin(), position_set.end(), expected_set.begin(), expected_set.end()));
+    EXPECT_EQ(std::string_view{str}, test_board.to_string());
+}
+
+TEST(SearchArena, IteratorOverloadsMatchAllocatingForms)
+{
+    for (const auto board : {BitBoard{}, BitBoard::make_full(), test_board, BitBoard{0x0123'4567'89ab'cdef}}) {
+        std::vector<BitBoard::Position> positions;
+        board.to_position_vector(std::back_inserter(positions));
+        EXPECT_EQ(positions, board.to_position_vector());
+
+        std::vector<BitBoard> boards;
+        board.to_bitboard_vector(std::back_inserter(boards));
+        EXPECT_EQ(boards, board.to_bitboard_vector());
+
+        std::set<BitBoard::Position> position_set;
+        board.to_position_set(std::inserter(position_set, position_set.end()));
+        EXPECT_EQ(position_set, board.to_position_set());
+
+        std::string str;
+        board.to_string(std::back_inserter(str));
+        EXPECT_EQ(str, board.to_string());
+    }
+}
+
+TEST(SearchArena, HotPathDoesNotAllocate)
+{
+    auto& arena = SearchArena::for_this_thread();
+    arena.reset();
+    std::array<BitBoard::Position, BitBoard::n_bits> position_buffer{};
+    std::array<char, BitBoard::n_bits> string_buffer{};
+
+    const AllocationCounter counter;
+    std::size_t total = 0;
+    for (int search = 0; search < 100; ++search) {
+        auto moves = arena.allocate_boards(256);
+        std::pmr::vector<BitBoard> undo_stack{&arena};
+        undo_stack.reserve(64);
+        undo_stack.push_back(test_board);
+        moves[0] = test_board;
+
+        total += test_board.to_position_vector(&arena).size();
+        total += test_board.to_bitboard_vector(&arena).size();
+        total += test_board.to_position_set(&arena).size();
+        total += test_board.to_string(&arena).size();
+        total += static_cast<std::size_t>(test_board.to_position_vector(position_buffer.begin()) - position_buffer.begin());
+        total += static_cast<std::size_t>(test_board.to_string(string_buffer.begin()) - string_buffer.begin());
+        arena.reset();
+    }
+    EXPECT_EQ(counter.count(), 0);
+    EXPECT_EQ(total, 100 * (4 * test_board.count() + 2 * BitBoard::n_bits));
+}
+
+TEST(SearchArena, AllocatingFormsAreCounted)
+{
+    const AllocationCounter counter;
+    EXPECT_EQ(test_board.to_position_vector().size(), 16);
+    EXPECT_GT(counter.count(), 0);
+}
+
+TEST(SearchArena, ResetAndCapacity)
+{
+    SearchArena arena{16};
+    EXPECT_EQ(arena.capacity(), 16);
+    static_cast<void>(arena.allocate_boards(10));
+    EXPECT_EQ(arena.used(), 10);
+    EXPECT_THROW(static_cast<void>(arena.allocate_boards(7)), std::bad_alloc);
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0);
+    EXPECT_EQ(arena.high_water_mark(), 10);
+    EXPECT_EQ(arena.allocate_boards(16).size(), 16);
+    EXPECT_NE(&SearchArena::for_this_thread(), &arena);
+}
@@ -0,0 +1,191 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "tablebase.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <map>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST(Tablebase, CombinationRanks)
+{
+    EXPECT_EQ(binomial(64, 32), 1832624140942590534ULL);
+    EXPECT_EQ(binomial(5, 6), 0);
+    for (const std::size_t k : {1, 2, 3}) {
+        for (std::uint64_t rank = 0; rank < binomial(10, k); ++rank) {
+            const auto bits = unrank_combination(rank, k);
+            ASSERT_EQ(std::popcount(bits), static_cast<int>(k));
+            ASSERT_LT(bits, BitBoard::Bits{1} << 10);
+            ASSERT_EQ(rank_combination(bits), rank);
+        }
+    }
+    std::mt19937_64 rng{39};
+    for (int i = 0; i < 1000; ++i) {
+        const auto bits = rng() & rng();
+        const auto k = static_cast<std::size_t>(std::popcount(bits));
+        ASSERT_EQ(unrank_combination(rank_combination(bits), k), bits);
+    }
+    static_assert(rank_combination(0b111) == 0);
+    static_assert(unrank_combination(binomial(64, 2) - 1, 2) == 0xc000'0000'0000'0000);
+}
+
+TEST(Tablebase, IndexerRoundTrip)
+{
+    const PlacementIndexer indexer{{1, 2}};
+    EXPECT_EQ(indexer.size(), 10 * binomial(63, 2));
+
+    std::array<BitBoard, 2> placement;
+    for (std::uint64_t index = 0; index < indexer.size(); index += 7) {
+        indexer.placement(index, placement);
+        ASSERT_EQ(placement[0].count(), 1);
+        ASSERT_EQ(placement[1].count(), 2);
+        ASSERT_FALSE(placement[0].test_any(placement[1]));
+        ASSERT_EQ(indexer.index(placement), index);
+    }
+    EXPECT_THROW(indexer.placement(indexer.size(), placement), std::out_of_range);
+
+    std::mt19937_64 rng{39};
+    for (int i = 0; i < 1000; ++i) {
+        const auto robber = BitBoard{BitBoard::Bits{1} << (rng() % 64)};
+        const auto cops = BitBoard{unrank_combination(rng() % binomial(64, 2), 2)};
+        if (robber.test_any(cops)) {
+            continue;
+        }
+        std::array placement_in{robber, cops};
+        indexer.canonicalize(placement_in);
+        EXPECT_EQ(placement_in[0], BitBoard::canonical(robber));
+        EXPECT_EQ(placement_in[1].count(), 2);
+
+        std::array rotated{BitBoard::rotate_clockwise(robber), BitBoard::rotate_clockwise(cops)};
+        indexer.canonicalize(rotated);
+        EXPECT_EQ(indexer.index(rotated), indexer.index(placement_in));
+    }
+
+    const std::array not_canonical{BitBoard::make_bottom_right(), BitBoard{0b11}};
+    EXPECT_THROW(static_cast<void>(indexer.index(not_canonical)), std::invalid_argument);
+    EXPECT_THROW(PlacementIndexer({}), std::invalid_argument);
+    EXPECT_THROW(PlacementIndexer({40, 30}), std::invalid_argument);
+}
+
+// Straightforward retrograde solver over uncompressed placements, for comparison.
+static std::map<std::pair<std::array<BitBoard::Bits, 2>, std::size_t>, Outcome> solve_naively(const CopsAndRobber& game)
+{
+    using Key = std::pair<std::array<BitBoard::Bits, 2>, std::size_t>;
+    std::map<Key, Outcome> outcomes;
+    std::vector<Key> keys;
+    for (std::size_t robber = 0; robber < 64; ++robber) {
+        for (std::size_t cop = 0; cop < 64; ++cop) {
+            if (cop != robber) {
+                for (std::size_t side = 0; side < 2; ++side) {
+                    keys.push_back({{BitBoard::Bits{1} << robber, BitBoard::Bits{1} << cop}, side});
+                }
+            }
+        }
+    }
+    for (const auto& key : keys) {
+        const std::array placement{BitBoard{key.first[0]}, BitBoard{key.first[1]}};
+        outcomes[key] = game.terminal(placement, key.second).value_or(Outcome::draw);
+    }
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (const auto& key : keys) {
+            if (outcomes[key] != Outcome::draw) {
+                continue;
+            }
+            const std::array placement{BitBoard{key.first[0]}, BitBoard{key.first[1]}};
+            bool any_move = false;
+            bool all_win = true;
+            bool found_loss = false;
+            game.for_each_successor(placement, key.second, [&](const std::span<const BitBoard> next) {
+                any_move = true;
+                const auto reply = outcomes[{{next[0].to_ullong(), next[1].to_ullong()}, 1 - key.second}];
+                found_loss = found_loss || reply == Outcome::loss;
+                all_win = all_win && reply == Outcome::win;
+                return true;
+            });
+            const auto outcome = found_loss ? Outcome::win : (!any_move || all_win ? Outcome::loss : Outcome::draw);
+            if (outcome != Outcome::draw) {
+                outcomes[key] = outcome;
+                changed = true;
+            }
+        }
+    }
+    return outcomes;
+}
+
+TEST(Tablebase, MatchesNaiveSolver)
+{
+    const CopsAndRobber game{1};
+    const auto tablebase = build_tablebase(game, TablebaseOptions{1});
+    const auto view = tablebase.view();
+    const PlacementIndexer indexer{game.group_sizes()};
+    EXPECT_EQ(view.entries(), indexer.size());
+    EXPECT_GT(view.passes(), 1);
+
+    const auto expected = solve_naively(game);
+    for (const auto& [key, outcome] : expected) {
+        const std::array placement{BitBoard{key.first[0]}, BitBoard{key.first[1]}};
+        ASSERT_EQ(view.probe(indexer, placement, key.second), outcome);
+    }
+    EXPECT_EQ(view.count(CopsAndRobber::cops_to_move, Outcome::illegal), 0);
+}
+
+TEST(Tablebase, ParallelBuildAndImage)
+{
+    const CopsAndRobber game{2};
+    const auto serial = build_tablebase(game, TablebaseOptions{1});
+    const auto parallel = build_tablebase(game, TablebaseOptions{4});
+    ASSERT_TRUE(std::ranges::equal(serial.view().bytes(), parallel.view().bytes()));
+
+    const auto view = serial.view();
+    EXPECT_GT(view.count(CopsAndRobber::cops_to_move, Outcome::win), 0);
+    EXPECT_GT(view.count(CopsAndRobber::cops_to_move, Outcome::draw), 0);
+    EXPECT_EQ(view.count(CopsAndRobber::robber_to_move, Outcome::win), 0);
+
+    // A cornered robber with a cop on each edge is lost, and so is every mirror image of the position.
+    const PlacementIndexer indexer{game.group_sizes()};
+    const std::array trapped{
+        BitBoard{BitBoard::Position{0, 0}},
+        BitBoard{BitBoard::Position{0, 2}} | BitBoard{BitBoard::Position{2, 0}},
+    };
+    for (const auto transform : {BitBoard::flip_vertical, BitBoard::rotate_clockwise, BitBoard::flip_anti_diagonal}) {
+        const std::array image{transform(trapped[0]), transform(trapped[1])};
+        EXPECT_EQ(view.probe(indexer, image, CopsAndRobber::robber_to_move), Outcome::loss);
+    }
+    EXPECT_EQ(view.group_sizes(), (std::vector<std::size_t>{1, 2}));
+
+    std::stringstream file;
+    serial.write(file);
+    const auto image = file.str();
+    const auto bytes = std::as_bytes(std::span{image});
+    const auto loaded = TablebaseView::from_bytes(bytes);
+    EXPECT_EQ(loaded.entries(), view.entries());
+    EXPECT_TRUE(std::ranges::equal(loaded.bytes(), view.bytes()));
+    EXPECT_THROW(static_cast<void>(TablebaseView::from_bytes(bytes.first(bytes.size() - 8))), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(TablebaseView::from_bytes(bytes.subspan(8))), std::invalid_argument);
+    EXPECT_EQ(Tablebase::from_bytes(bytes).view().passes(), view.passes());
+
+    // Header words: group count at 8, group sizes one per byte at 16, entries at 24.
+    const auto rejects = [&](const std::size_t offset, const std::uint64_t value) {
+        std::vector<std::byte> corrupt(bytes.begin(), bytes.end());
+        std::memcpy(corrupt.data() + offset, &value, sizeof(value));
+        EXPECT_THROW(static_cast<void>(TablebaseView::from_bytes(corrupt)), std::invalid_argument) << value;
+    };
+    rejects(16, 0x0001);
+    rejects(16, 0x0102);
+    rejects(16, 0x0302'0201);
+    rejects(16, 0x4001);
+    rejects(24, view.entries() - 1);
+}
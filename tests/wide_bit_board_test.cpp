@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+
+#include "bit_board.h"
+#include "cpu_features.h"
+#include "wide_bit_board.h"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using Position = GoBitBoard::Position;
+
+static GoBitBoard random_go_board(std::mt19937_64& rng)
+{
+    GoBitBoard board;
+    for (int x = 0; x < 19; ++x) {
+        for (int y = 0; y < 19; ++y) {
+            if (rng() % 3 == 0) {
+                board.set(Position{x, y});
+            }
+        }
+    }
+    return board;
+}
+
+static GoBitBoard naive_neighbors(const GoBitBoard& board, const bool cardinal, const bool diagonal)
+{
+    GoBitBoard result;
+    for (const auto& position : board.to_position_vector()) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                const bool is_diagonal = dx != 0 && dy != 0;
+                const bool is_cardinal = (dx == 0) != (dy == 0);
+                if ((is_cardinal && cardinal) || (is_diagonal && diagonal)) {
+                    const Position neighbor{position.x() + dx, position.y() + dy};
+                    if (neighbor.x() >= 0 && neighbor.x() < 19 && neighbor.y() >= 0 && neighbor.y() < 19) {
+                        result.set(neighbor);
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+TEST(WideBitBoard, Layout)
+{
+    static_assert(GoBitBoard::n_bits == 361);
+    static_assert(GoBitBoard::n_words % GoBitBoard::words_per_vector == 0);
+    static_assert(GoBitBoard::row_mask == 0x7ffff);
+
+    EXPECT_TRUE(GoBitBoard{}.empty());
+    EXPECT_EQ(GoBitBoard::make_full().count(), 361);
+    EXPECT_EQ(GoBitBoard::make_all_edge().count(), 4 * 18);
+    EXPECT_EQ(GoBitBoard::make_row(3).count(), 19);
+    EXPECT_EQ(GoBitBoard::make_column(18).count(), 19);
+    EXPECT_EQ(GoBitBoard{}.set(Position{0, 0}).row_bits(0), GoBitBoard::Bits{1} << 18);
+    EXPECT_EQ(~GoBitBoard::make_full(), GoBitBoard{});
+}
+
+TEST(WideBitBoard, SetTestClear)
+{
+    GoBitBoard board{Position{18, 18}};
+    EXPECT_TRUE(board.test(Position{18, 18}));
+    EXPECT_FALSE(board.test(Position{18, 17}));
+    board.set(Position{9, 0});
+    EXPECT_EQ(board.to_position_vector(), (std::vector<Position>{{9, 0}, {18, 18}}));
+    board.clear(Position{18, 18});
+    EXPECT_EQ(board.count(), 1);
+    EXPECT_THROW(board.set(Position{19, 0}), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(board.test(Position{0, -1})), std::invalid_argument);
+}
+
+TEST(WideBitBoard, Shift)
+{
+    const GoBitBoard center{Position{9, 9}};
+    EXPECT_EQ(GoBitBoard::shift<Direction::up>(center, 2), (GoBitBoard{Position{7, 9}}));
+    EXPECT_EQ(GoBitBoard::shift<Direction::down>(center, 9), (GoBitBoard{Position{18, 9}}));
+    EXPECT_EQ(GoBitBoard::shift<Direction::left>(center, 9), (GoBitBoard{Position{9, 0}}));
+    EXPECT_EQ(GoBitBoard::shift<Direction::right>(center, 3), (GoBitBoard{Position{9, 12}}));
+    EXPECT_EQ(GoBitBoard::shift<Direction::upleft>(center), (GoBitBoard{Position{8, 8}}));
+    EXPECT_EQ(GoBitBoard::shift<Direction::downright>(center, 4), (GoBitBoard{Position{13, 13}}));
+
+    EXPECT_TRUE(GoBitBoard::shift<Direction::down>(center, 10).empty());
+    EXPECT_TRUE(GoBitBoard::shift<Direction::right>(center, 10).empty());
+    EXPECT_TRUE(GoBitBoard::shift<Direction::left>(GoBitBoard::make_column(0)).empty());
+    EXPECT_TRUE(GoBitBoard::shift<Direction::up>(GoBitBoard::make_row(0)).empty());
+    EXPECT_EQ(GoBitBoard::shift<Direction::right>(GoBitBoard::make_full()).count(), 19 * 18);
+}
+
+TEST(WideBitBoard, Dilate)
+{
+    GoBitBoard board{Position{0, 0}};
+    board.dilate<Direction::right>(18);
+    EXPECT_EQ(board, GoBitBoard::make_row(0));
+    board.dilate<Direction::down>(18);
+    EXPECT_EQ(board, GoBitBoard::make_full());
+}
+
+TEST(WideBitBoard, NeighborsMatchNaiveAllLevels)
+{
+    std::mt19937_64 rng{32};
+    std::vector<GoBitBoard> boards{GoBitBoard{}, GoBitBoard::make_full(), GoBitBoard::make_all_edge()};
+    while (boards.size() < 50) {
+        boards.push_back(random_go_board(rng));
+    }
+
+    for (auto level = CpuLevel::generic; level <= detected_cpu_level();
+         level = static_cast<CpuLevel>(static_cast<int>(level) + 1)) {
+        SCOPED_TRACE(to_string(level));
+        force_cpu_level(level);
+        for (const auto& board : boards) {
+            EXPECT_EQ(GoBitBoard::neighbors_cardinal(board), naive_neighbors(board, true, false));
+            EXPECT_EQ(GoBitBoard::neighbors_diagonal(board), naive_neighbors(board, false, true));
+            EXPECT_EQ(GoBitBoard::neighbors_cardinal_and_diagonal(board), naive_neighbors(board, true, true));
+        }
+    }
+    reset_cpu_level();
+}
+
+TEST(WideBitBoard, FloodFill)
+{
+    auto walls = GoBitBoard::make_column(9);
+    walls.clear(Position{18, 9});
+    const auto open = ~walls;
+
+    const auto left = GoBitBoard::flood_fill(GoBitBoard{Position{0, 0}}, open);
+    EXPECT_EQ(left.count(), 361 - 18);
+    EXPECT_TRUE(left.test(Position{0, 18}));
+
+    walls.set(Position{18, 9});
+    const auto sealed = GoBitBoard::flood_fill(GoBitBoard{Position{0, 0}}, ~walls);
+    EXPECT_EQ(sealed.count(), 19 * 9);
+    EXPECT_FALSE(sealed.test(Position{0, 10}));
+}
+
+TEST(WideBitBoard, SmallerShapes)
+{
+    using Board = WideBitBoard<3, 64>;
+    static_assert(Board::row_mask == ~Board::Bits{0});
+    const Board corner{Position{0, 63}};
+    EXPECT_EQ(Board::neighbors_cardinal(corner).to_position_vector(), (std::vector<Position>{{0, 62}, {1, 63}}));
+    EXPECT_EQ(Board::make_full().count(), 192);
+}